@@ -4,21 +4,27 @@
 
 # Add inputs and outputs from these tool invocations to the build variables 
 CPP_SRCS += \
-../general_timer/general_timer.cpp 
+../general_timer/general_timer.cpp \
+../general_timer/timer_wheel.cpp 
 
 OBJS += \
-./general_timer/general_timer.obj 
+./general_timer/general_timer.obj \
+./general_timer/timer_wheel.obj 
 
 CPP_DEPS += \
-./general_timer/general_timer.d 
+./general_timer/general_timer.d \
+./general_timer/timer_wheel.d 
 
 OBJS__QUOTED += \
-"general_timer/general_timer.obj" 
+"general_timer/general_timer.obj" \
+"general_timer/timer_wheel.obj" 
 
 CPP_DEPS__QUOTED += \
-"general_timer/general_timer.d" 
+"general_timer/general_timer.d" \
+"general_timer/timer_wheel.d" 
 
 CPP_SRCS__QUOTED += \
-"../general_timer/general_timer.cpp" 
+"../general_timer/general_timer.cpp" \
+"../general_timer/timer_wheel.cpp" 
 
 
@@ -5,32 +5,62 @@
 # Add inputs and outputs from these tool invocations to the build variables 
 CPP_SRCS += \
 ../src/lcd_driver.cpp \
+../src/lcd_instrument.cpp \
+../src/lcd_record.cpp \
+../src/lcd_trace.cpp \
+../src/lcd_tx_engine.cpp \
 ../src/lcd_utils.cpp \
+../src/lcd_waveform.cpp \
 ../src/main.cpp 
 
 OBJS += \
 ./src/lcd_driver.obj \
+./src/lcd_instrument.obj \
+./src/lcd_record.obj \
+./src/lcd_trace.obj \
+./src/lcd_tx_engine.obj \
 ./src/lcd_utils.obj \
+./src/lcd_waveform.obj \
 ./src/main.obj 
 
 CPP_DEPS += \
 ./src/lcd_driver.d \
+./src/lcd_instrument.d \
+./src/lcd_record.d \
+./src/lcd_trace.d \
+./src/lcd_tx_engine.d \
 ./src/lcd_utils.d \
+./src/lcd_waveform.d \
 ./src/main.d 
 
 OBJS__QUOTED += \
 "src/lcd_driver.obj" \
+"src/lcd_instrument.obj" \
+"src/lcd_record.obj" \
+"src/lcd_trace.obj" \
+"src/lcd_tx_engine.obj" \
 "src/lcd_utils.obj" \
+"src/lcd_waveform.obj" \
 "src/main.obj" 
 
 CPP_DEPS__QUOTED += \
 "src/lcd_driver.d" \
+"src/lcd_instrument.d" \
+"src/lcd_record.d" \
+"src/lcd_trace.d" \
+"src/lcd_tx_engine.d" \
 "src/lcd_utils.d" \
+"src/lcd_waveform.d" \
 "src/main.d" 
 
 CPP_SRCS__QUOTED += \
 "../src/lcd_driver.cpp" \
+"../src/lcd_instrument.cpp" \
+"../src/lcd_record.cpp" \
+"../src/lcd_trace.cpp" \
+"../src/lcd_tx_engine.cpp" \
 "../src/lcd_utils.cpp" \
+"../src/lcd_waveform.cpp" \
 "../src/main.cpp" 
 
 
@@ -6,6 +6,7 @@
 
 // TivaC
 // peripheral
+#include "driverlib/cpu.h"
 #include "driverlib/gpio.h"
 #include "driverlib/interrupt.h"
 #include "driverlib/pin_map.h"
@@ -19,6 +20,7 @@
 #include "Tivaware_Dep/inc/hw_timer.h"
 #include "inc/hw_ints.h"
 #include "inc/hw_memmap.h"
+#include "inc/hw_nvic.h"
 #include "inc/hw_types.h"
 
 // timer value config
@@ -29,11 +31,23 @@ static const uint32_t TIMER_MODE = TIMER_CFG_PERIODIC_UP;
 static const uint32_t TIMER_BASE  = WTIMER0_BASE;
 static const uint32_t TIMER_CLOCK = SYSCTL_PERIPH_WTIMER0;
 static const uint32_t TIMER_NAME  = TIMER_A;
+static const uint32_t TIMER_INT   = INT_WTIMER0A;
 
-bool GeneralTimer::_isConfigured = false;
+// timer ticks in a wheel tick minus 1
+static const uint64_t WHEEL_TICK_MASK = (1ull << GENERAL_TIMER_WHEEL_TICK_SHIFT) - 1;
+
+bool             GeneralTimer::_isConfigured    = false;
+GeneralTimerStat GeneralTimer::_stat            = {0, 0, 0, 0, 0};
+bool             GeneralTimer::_isCycleCountDwt = false;
+uint32_t         GeneralTimer::_sysTickPeriod   = 0;
+uint32_t         GeneralTimer::_cycleWaitMax    = 0;
+uint64_t         GeneralTimer::_sleepWaitMin    = UINT64_MAX;
+TimerWheel       GeneralTimer::_timerWheel;
 
 GeneralTimer::GeneralTimer(TimerUnit timerUnit)
-    : _tickToTimeScale(timerUnit / (double)(SysCtlClockGet())) {
+    : _tickToTimeScale(scaleCreate(timerUnit, SysCtlClockGet())),
+      _timeToTickScale(scaleCreate(SysCtlClockGet(), timerUnit)),
+      _isClockAsBuilt(GENERAL_TIMER_CLOCK_HZ == SysCtlClockGet()) {
   if (false == _isConfigured) {
     ROM_SysCtlPeripheralEnable(TIMER_CLOCK);
     while (!ROM_SysCtlPeripheralReady(TIMER_CLOCK)) {
@@ -43,11 +57,38 @@ GeneralTimer::GeneralTimer(TimerUnit timerUnit)
     // use a concacentated 64 bit timer clock
     TimerConfigure(TIMER_BASE, TIMER_MODE);
     TimerLoadSet64(TIMER_BASE, TIMER_LOAD);
+    // the up count mode has the match interrupt on, it's only moved off the end by timeoutAdd()
+    TimerMatchSet64(TIMER_BASE, TIMER_LOAD);
+    TimerIntEnable(TIMER_BASE, TIMER_TIMA_MATCH);
     TimerEnable(TIMER_BASE, TIMER_NAME);
+    cycleCounterInit();
     _isConfigured = true;
   }
 }
 
+void GeneralTimer::cycleCounterInit(void) {
+  GENERAL_TIMER_REG_WRITE(GENERAL_TIMER_DEMCR,
+                          GENERAL_TIMER_REG_READ(GENERAL_TIMER_DEMCR) | GENERAL_TIMER_DEMCR_TRCENA);
+  const uint32_t dwtControl = GENERAL_TIMER_REG_READ(GENERAL_TIMER_DWT_CTRL);
+  if (0 == (dwtControl & GENERAL_TIMER_DWT_CTRL_NOCYCCNT)) {
+    GENERAL_TIMER_REG_WRITE(GENERAL_TIMER_DWT_CTRL, dwtControl | GENERAL_TIMER_DWT_CTRL_CYCCNTENA);
+    _isCycleCountDwt = true;
+    // half the range so a wait still ends if an interrupt delays the compare
+    _cycleWaitMax = 0x80000000;
+    return;
+  }
+
+  // keep SysTick as it is if the application already runs it
+  if (0 == (GENERAL_TIMER_REG_READ(NVIC_ST_CTRL) & NVIC_ST_CTRL_ENABLE)) {
+    GENERAL_TIMER_REG_WRITE(NVIC_ST_RELOAD, NVIC_ST_RELOAD_M);
+    GENERAL_TIMER_REG_WRITE(NVIC_ST_CURRENT, 0);
+    GENERAL_TIMER_REG_WRITE(NVIC_ST_CTRL, NVIC_ST_CTRL_CLK_SRC | NVIC_ST_CTRL_ENABLE);
+  }
+  _isCycleCountDwt = false;
+  _sysTickPeriod   = (GENERAL_TIMER_REG_READ(NVIC_ST_RELOAD) & NVIC_ST_RELOAD_M) + 1;
+  _cycleWaitMax    = _sysTickPeriod / 2;
+}
+
 void GeneralTimer::startTimer(uint64_t& timeStamp) {
   timeStamp = getTimeStamp(TIMER_BASE, TIMER_NAME);
 }
@@ -56,15 +97,19 @@ uint64_t GeneralTimer::getTimeStamp(uint32_t timerBase, uint32_t timerName) {
   return TimerValueGet64(timerBase);
 }
 
-uint64_t tickToNanoSec(uint64_t tickCount);
+uint64_t GeneralTimer::tickGet(void) { return TimerValueGet64(TIMER_BASE); }
 
-uint64_t inline GeneralTimer::tickToTime(const uint64_t& tickCount) {
-  return (tickCount * _tickToTimeScale);
-}
-uint64_t inline GeneralTimer::timeToTick(const uint64_t& timeAmount) {
-  assert(_tickToTimeScale != 0);
-  return (timeAmount / _tickToTimeScale);
+// the 64 bit division is only done here, once per timer
+GeneralTimerScale GeneralTimer::scaleCreate(const uint64_t& numerator,
+                                            const uint64_t& denominator) {
+  assert(denominator != 0);
+  GeneralTimerScale scale;
+  scale.intPart = numerator / denominator;
+  // remainder < denominator so this rounds to at most 2^32 - 1
+  scale.fracPart = (((numerator % denominator) << 32) + denominator / 2) / denominator;
+  return scale;
 }
+
 // return time elapsed in variable unit
 uint64_t GeneralTimer::stopTimer(const uint64_t& intialTimeStamp) {
   uint64_t currTimeStamp = getTimeStamp(TIMER_BASE, TIMER_NAME);
@@ -78,9 +123,8 @@ uint64_t GeneralTimer::stopTimer(const uint64_t& intialTimeStamp) {
   }
 }
 
-void GeneralTimer::wait(const uint64_t& timeToWait) {
+void GeneralTimer::timerWait(const uint64_t& tickToWait) {
   uint64_t currTimeStamp  = TimerValueGet64(TIMER_BASE);
-  uint64_t tickToWait     = timeToTick(timeToWait);
   uint64_t overFlowOffset = 0;
   while (TimerValueGet64(TIMER_BASE) + overFlowOffset - currTimeStamp < tickToWait) {
     if (currTimeStamp > TimerValueGet64(TIMER_BASE)) {
@@ -88,4 +132,103 @@ void GeneralTimer::wait(const uint64_t& timeToWait) {
     }
     // wait until the count is over
   }
-}
\ No newline at end of file
+}
+
+void GeneralTimer::sleepWaitSet(const uint64_t& minTime) {
+  _sleepWaitMin = (0 == minTime) ? UINT64_MAX : timeToTick(minTime);
+}
+
+// the wake up needs the match interrupt to run, which can't happen from an interrupt or with
+// interrupts off
+bool GeneralTimer::isSleepAllowed(void) {
+  return (0 == (GENERAL_TIMER_REG_READ(NVIC_INT_CTRL) & NVIC_INT_CTRL_VEC_ACT_M)) &&
+         (0 == CPUprimask());
+}
+
+void GeneralTimer::sleepWaitDone(void* context) { *(volatile bool*)context = true; }
+
+void GeneralTimer::sleepWait(const uint64_t& tickToWait) {
+  const uint64_t  wakeTick   = TimerValueGet64(TIMER_BASE) + tickToWait;
+  volatile bool   isWaitDone = false;
+  TimerWheelEntry wakeEntry  = TimerWheelEntry();
+  timeoutTickAdd(wakeEntry, wakeTick, 0, sleepWaitDone, (void*)&isWaitDone);
+
+  // interrupts are off between the check and the WFI so the wake up can't slip in between, a
+  // pending interrupt still ends the WFI and runs as soon as they are back on
+  IntMasterDisable();
+  while (!isWaitDone) {
+    CPUwfi();
+    IntMasterEnable();
+    IntMasterDisable();
+  }
+  IntMasterEnable();
+
+  const uint64_t lateTick = TimerValueGet64(TIMER_BASE) - wakeTick;
+  ++_stat.sleepCall;
+  _stat.wakeLateTick += lateTick;
+  if (lateTick > _stat.wakeLateTickMax) { _stat.wakeLateTickMax = lateTick; }
+}
+
+const GeneralTimerStat& GeneralTimer::statGet(void) { return _stat; }
+
+void GeneralTimer::statReset(void) { _stat = GeneralTimerStat(); }
+
+void GeneralTimer::timeoutAdd(TimerWheelEntry&         entry,
+                              const uint64_t&          delay,
+                              const uint64_t&          period,
+                              const TimerWheelCallback callback,
+                              void*                    context) {
+  timeoutTickAdd(entry,
+                 getTimeStamp(TIMER_BASE, TIMER_NAME) + timeToTick(delay),
+                 timeToTick(period),
+                 callback,
+                 context);
+}
+
+void GeneralTimer::timeoutTickAdd(TimerWheelEntry&         entry,
+                                  const uint64_t&          expireTick,
+                                  const uint64_t&          periodTick,
+                                  const TimerWheelCallback callback,
+                                  void*                    context) {
+  // round up so the callback never runs early
+  const uint64_t wheelExpireTick = (expireTick + WHEEL_TICK_MASK) >> GENERAL_TIMER_WHEEL_TICK_SHIFT;
+  const uint64_t wheelPeriodTick = (periodTick + WHEEL_TICK_MASK) >> GENERAL_TIMER_WHEEL_TICK_SHIFT;
+
+  IntDisable(TIMER_INT);
+  // an empty wheel has nothing to run, catching it up keeps the new entry out of the top level
+  if (0 == _timerWheel.totalArmedGet()) {
+    _timerWheel.restart(TimerValueGet64(TIMER_BASE) >> GENERAL_TIMER_WHEEL_TICK_SHIFT);
+  }
+  _timerWheel.add(entry, wheelExpireTick, wheelPeriodTick, callback, context);
+  wheelMatchSet();
+  IntEnable(TIMER_INT);
+}
+
+void GeneralTimer::timeoutCancel(TimerWheelEntry& entry) {
+  // the match isn't moved, an early interrupt finds nothing to run
+  IntDisable(TIMER_INT);
+  _timerWheel.cancel(entry);
+  IntEnable(TIMER_INT);
+}
+
+// only called with the match interrupt masked or from it
+void GeneralTimer::wheelMatchSet(void) {
+  uint64_t nextTick = 0;
+  if (!_timerWheel.nextTickGet(nextTick)) {
+    TimerMatchSet64(TIMER_BASE, TIMER_LOAD);
+    return;
+  }
+
+  const uint64_t matchTick = nextTick << GENERAL_TIMER_WHEEL_TICK_SHIFT;
+  TimerMatchSet64(TIMER_BASE, matchTick);
+  // the interrupt only fires when the count reaches the match, not if it's already past
+  if (TimerValueGet64(TIMER_BASE) >= matchTick) { IntPendSet(TIMER_INT); }
+}
+
+void GeneralTimer::wheelIntHandle(void) {
+  TimerIntClear(TIMER_BASE, TIMER_TIMA_MATCH);
+  _timerWheel.advance(TimerValueGet64(TIMER_BASE) >> GENERAL_TIMER_WHEEL_TICK_SHIFT);
+  wheelMatchSet();
+}
+
+void GeneralTimerIntHandler(void) { GeneralTimer::wheelIntHandle(); }
\ No newline at end of file
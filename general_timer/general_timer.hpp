@@ -1,28 +1,196 @@
 #ifndef _GENERAL_TIMER_HPP
 #define _GENERAL_TIMER_HPP
 
+#include <cassert>
 #include <cinttypes>
 
+// hardware
+#include "inc/hw_nvic.h"
+#include "inc/hw_types.h"
+
+#include "timer_wheel.hpp"
+
 enum TimerUnit : uint64_t {
   UNIT_MILLISEC = 1000,
   UNIT_MICROSEC = 1000000,
   UNIT_NANOSEC  = 1000000000
 };
 
+// system clock assumed by the compile time conversions, GeneralTimer checks it against the real one
+#ifndef GENERAL_TIMER_CLOCK_HZ
+#define GENERAL_TIMER_CLOCK_HZ 80000000
+#endif
+
+// Cortex-M4 cycle counter registers, TivaWare doesn't have them
+#define GENERAL_TIMER_DEMCR NVIC_DBG_INT             // debug exception and monitor control
+#define GENERAL_TIMER_DEMCR_TRCENA 0x01000000        // turns on the DWT
+#define GENERAL_TIMER_DWT_CTRL 0xE0001000            // DWT control
+#define GENERAL_TIMER_DWT_CTRL_CYCCNTENA 0x00000001  // CYCCNT counts
+#define GENERAL_TIMER_DWT_CTRL_NOCYCCNT 0x02000000   // this core has no CYCCNT
+#define GENERAL_TIMER_DWT_CYCCNT 0xE0001004          // core cycles, wraps at 2^32
+
+#ifdef LCD_HOST_SIM
+// the host simulator has no core registers, it provides the ones used by GeneralTimer
+uint32_t simCoreRegRead(const uint32_t& regAddr);
+void     simCoreRegWrite(const uint32_t& regAddr, const uint32_t& value);
+#define GENERAL_TIMER_REG_READ(regAddr) simCoreRegRead(regAddr)
+#define GENERAL_TIMER_REG_WRITE(regAddr, value) simCoreRegWrite(regAddr, value)
+#else
+#define GENERAL_TIMER_REG_READ(regAddr) HWREG(regAddr)
+#define GENERAL_TIMER_REG_WRITE(regAddr, value) (HWREG(regAddr) = (value))
+#endif
+
+// timeouts are kept in slots of 2^GENERAL_TIMER_WHEEL_TICK_SHIFT timer ticks, 0.8 us at 80 MHz
+#ifndef GENERAL_TIMER_WHEEL_TICK_SHIFT
+#define GENERAL_TIMER_WHEEL_TICK_SHIFT 6
+#endif
+
+// match interrupt handler of the wide timer, has to be in the vector table to use timeoutAdd()
+extern "C" void GeneralTimerIntHandler(void);
+
+// multiplier of intPart + fracPart / 2^32, lets the tick conversion run without float or division
+typedef struct {
+  uint64_t intPart;
+  uint32_t fracPart;
+} GeneralTimerScale;
+
+// totals of every wait() of every GeneralTimer since the last statReset()
+typedef struct {
+  uint64_t waitCall;
+  uint64_t waitTick;         // ticks of the timer clock asked for
+  uint64_t sleepCall;        // waits that slept with WFI
+  uint64_t wakeLateTick;     // ticks that the sleeping waits ended after they were due
+  uint64_t wakeLateTickMax;  // most that a single sleeping wait ended late
+} GeneralTimerStat;
+
 // the sole purpose is for timing, doesn't implement all features of the tiva timer
+// the wide timer keeps the time stamps, waits shorter than the core cycle counter can time spin on
+// it(DWT CYCCNT, SysTick if the core has no CYCCNT) since the timers run at the core clock
+// its match interrupt drives a TimerWheel so callbacks can be run later without another timer
 class GeneralTimer {
  private:
-  static bool _isConfigured;
-  double      _tickToTimeScale;
-  uint64_t    tickToTime(const uint64_t& tickCount);
-  uint64_t    timeToTick(const uint64_t& time);
-  uint64_t    getTimeStamp(uint32_t timerBase, uint32_t timerName);
+  friend void ::GeneralTimerIntHandler(void);
+  static TimerWheel       _timerWheel;
+  static bool             _isConfigured;
+  static GeneralTimerStat _stat;
+  static bool             _isCycleCountDwt;  // DWT CYCCNT is used, SysTick otherwise
+  static uint32_t         _sysTickPeriod;    // SysTick reload + 1
+  static uint32_t         _cycleWaitMax;     // waits from this long use the wide timer
+  static uint64_t         _sleepWaitMin;     // waits from this long sleep
+  GeneralTimerScale       _tickToTimeScale;
+  GeneralTimerScale       _timeToTickScale;
+  bool                    _isClockAsBuilt;  // SysCtlClockGet() is GENERAL_TIMER_CLOCK_HZ
+  uint64_t                getTimeStamp(uint32_t timerBase, uint32_t timerName);
+  void                    timerWait(const uint64_t& tickToWait);
+  static bool             isSleepAllowed(void);
+  static void             sleepWait(const uint64_t& tickToWait);
+  static void             sleepWaitDone(void* context);
+  static void             cycleCounterInit(void);
+  static void             wheelMatchSet(void);
+  static void             timeoutTickAdd(TimerWheelEntry&         entry,
+                                         const uint64_t&          expireTick,
+                                         const uint64_t&          periodTick,
+                                         const TimerWheelCallback callback,
+                                         void*                    context);
+  static void             wheelIntHandle(void);
+
+  static GeneralTimerScale scaleCreate(const uint64_t& numerator, const uint64_t& denominator);
+
+  // the fraction is applied to both 32 bit halves of the value separately so nothing overflows
+  static uint64_t scaleApply(const uint64_t& value, const GeneralTimerScale& scale) {
+    return value * scale.intPart + (value >> 32) * scale.fracPart +
+           (((value & 0xffffffff) * scale.fracPart) >> 32);
+  }
+
+  // spin on the cycle counter, only register reads and a compare, has to be < _cycleWaitMax
+  static void cycleWait(const uint32_t cycleToWait) {
+    if (_isCycleCountDwt) {
+      const uint32_t startCycle = GENERAL_TIMER_REG_READ(GENERAL_TIMER_DWT_CYCCNT);
+      while (GENERAL_TIMER_REG_READ(GENERAL_TIMER_DWT_CYCCNT) - startCycle < cycleToWait) {
+        // wait until the count is over
+      }
+    } else {
+      // SysTick counts down and wraps to its reload value
+      const uint32_t startCycle   = GENERAL_TIMER_REG_READ(NVIC_ST_CURRENT);
+      uint32_t       elapsedCycle = 0;
+      while (elapsedCycle < cycleToWait) {
+        const uint32_t currCycle = GENERAL_TIMER_REG_READ(NVIC_ST_CURRENT);
+        elapsedCycle             = (startCycle >= currCycle)
+                           ? (startCycle - currCycle)
+                           : (startCycle + _sysTickPeriod - currCycle);
+      }
+    }
+  }
 
  public:
   GeneralTimer(TimerUnit timerUnit);
   void     startTimer(uint64_t& timeStamp);
   uint64_t stopTimer(const uint64_t& intialTimeStamp);
-  void     wait(const uint64_t& timeToWait);
+  uint64_t tickToTime(const uint64_t& tickCount) { return scaleApply(tickCount, _tickToTimeScale); }
+  uint64_t timeToTick(const uint64_t& time) { return scaleApply(time, _timeToTickScale); }
+
+  void wait(const uint64_t& timeToWait) { waitTick(timeToTick(timeToWait)); }
+
+  void waitTick(const uint64_t& tickToWait) {
+    ++_stat.waitCall;
+    _stat.waitTick += tickToWait;
+    if ((tickToWait >= _sleepWaitMin) && isSleepAllowed()) {
+      sleepWait(tickToWait);
+    } else if (tickToWait < _cycleWaitMax) {
+      cycleWait(tickToWait);
+    } else {
+      timerWait(tickToWait);
+    }
+  }
+
+  // waits from minTime in the unit of this timer sleep with WFI until the wide timer match wakes
+  // the core, other interrupts run in between, 0 to always spin, GeneralTimerIntHandler has to be
+  // in the vector table, waits from an interrupt or with interrupts off still spin
+  void sleepWaitSet(const uint64_t& minTime);
+
+  // conversion done by the compiler, only valid when running at GENERAL_TIMER_CLOCK_HZ
+  static constexpr uint64_t timeToTickConst(const uint64_t time, const TimerUnit timerUnit) {
+    return time * GENERAL_TIMER_CLOCK_HZ / timerUnit;
+  }
+
+  // wait for a duration known at compile time, no conversion is done at run time
+  template <uint64_t TimeToWait, TimerUnit Unit = UNIT_NANOSEC>
+  void waitConst(void) {
+    constexpr uint64_t tickToWait = timeToTickConst(TimeToWait, Unit);
+    assert(_isClockAsBuilt);
+    waitTick(tickToWait);
+  }
+
+  // run callback from the match interrupt after delay then every period if it's not 0, both in the
+  // unit of this timer and rounded up to the wheel tick, an armed entry is moved
+  void timeoutAdd(TimerWheelEntry&         entry,
+                  const uint64_t&          delay,
+                  const uint64_t&          period,
+                  const TimerWheelCallback callback,
+                  void*                    context);
+
+  // the callback won't run after this returns, unless it's the one running
+  static void timeoutCancel(TimerWheelEntry& entry);
+
+  // core cycle counter for timing short stretches of code, only differences of it mean something
+  static uint32_t cycleCountGet(void) {
+    return _isCycleCountDwt ? GENERAL_TIMER_REG_READ(GENERAL_TIMER_DWT_CYCCNT)
+                            : GENERAL_TIMER_REG_READ(NVIC_ST_CURRENT);
+  }
+
+  // cycles since cycleCountGet() returned startCount, SysTick only times up to its period
+  static uint32_t cycleElapsedGet(const uint32_t startCount) {
+    if (_isCycleCountDwt) { return GENERAL_TIMER_REG_READ(GENERAL_TIMER_DWT_CYCCNT) - startCount; }
+    const uint32_t currCount = GENERAL_TIMER_REG_READ(NVIC_ST_CURRENT);
+    return (startCount >= currCount) ? (startCount - currCount)
+                                     : (startCount + _sysTickPeriod - currCount);
+  }
+
+  // count of the wide timer, for stamping events without a GeneralTimer at hand
+  static uint64_t tickGet(void);
+
+  static const GeneralTimerStat& statGet(void);
+  static void                    statReset(void);
 };
 
 #endif
\ No newline at end of file
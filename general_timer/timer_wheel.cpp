@@ -0,0 +1,170 @@
+#include "timer_wheel.hpp"
+
+#include <cassert>
+#include <cinttypes>
+
+// slot of the entries taken out of a level 0 slot that are being run
+static const uint32_t TIMER_WHEEL_DUE_SLOT = TIMER_WHEEL_LEVEL * TIMER_WHEEL_SLOT;
+
+// furthest a timeout can be put from the current tick, the top level can't tell turns apart
+static const uint64_t TIMER_WHEEL_MAX_DELTA =
+    (1ull << (TIMER_WHEEL_SLOT_BIT * TIMER_WHEEL_LEVEL)) - 1;
+
+// index of the lowest set bit, de Bruijn multiply since not every compiler has a builtin for it
+static uint32_t lowestBitGet(const uint64_t& value) {
+  static const uint8_t DE_BRUIJN_INDEX[64] = {
+      0,  1,  2,  53, 3,  7,  54, 27, 4,  38, 41, 8,  34, 55, 48, 28, 62, 5,  39, 46, 44, 42,
+      22, 9,  24, 35, 59, 56, 49, 18, 29, 11, 63, 52, 6,  26, 37, 40, 33, 47, 61, 45, 43, 21,
+      23, 58, 17, 10, 51, 25, 36, 32, 60, 20, 57, 16, 50, 31, 19, 15, 30, 14, 13, 12};
+  assert(0 != value);
+  return DE_BRUIJN_INDEX[((value & (~value + 1)) * 0x022FDD63CC95386Dull) >> 58];
+}
+
+static uint64_t rotateRight(const uint64_t& value, const uint32_t& shift) {
+  return (value >> shift) | (value << ((64 - shift) & 63));
+}
+
+TimerWheel::TimerWheel() : _dueList(nullptr), _currTick(0), _totalArmed(0) {
+  for (uint32_t level = 0; level < TIMER_WHEEL_LEVEL; ++level) {
+    for (uint32_t slot = 0; slot < TIMER_WHEEL_SLOT; ++slot) { _slotList[level][slot] = nullptr; }
+    _slotUsed[level] = 0;
+  }
+}
+
+void TimerWheel::slotInsert(TimerWheelEntry& entry) {
+  assert(entry.expireTick >= _currTick);
+  uint64_t delta    = entry.expireTick - _currTick;
+  uint64_t slotTick = entry.expireTick;
+  if (delta > TIMER_WHEEL_MAX_DELTA) {
+    // parked in the last slot the top level reaches, it's put back once that slot moves down
+    delta    = TIMER_WHEEL_MAX_DELTA;
+    slotTick = _currTick + TIMER_WHEEL_MAX_DELTA;
+  }
+
+  uint32_t level = 0;
+  while (delta >> (TIMER_WHEEL_SLOT_BIT * (level + 1))) { ++level; }
+  const uint32_t slot = (slotTick >> (TIMER_WHEEL_SLOT_BIT * level)) & TIMER_WHEEL_SLOT_MASK;
+
+  TimerWheelEntry*& head = _slotList[level][slot];
+  entry.next             = head;
+  if (head) { head->prevNext = &entry.next; }
+  head           = &entry;
+  entry.prevNext = &head;
+  entry.slot     = level * TIMER_WHEEL_SLOT + slot;
+  _slotUsed[level] |= 1ull << slot;
+}
+
+void TimerWheel::slotRemove(TimerWheelEntry& entry) {
+  *entry.prevNext = entry.next;
+  if (entry.next) { entry.next->prevNext = entry.prevNext; }
+  entry.next     = nullptr;
+  entry.prevNext = nullptr;
+
+  if (TIMER_WHEEL_DUE_SLOT == entry.slot) { return; }
+  const uint32_t level = entry.slot >> TIMER_WHEEL_SLOT_BIT;
+  const uint32_t slot  = entry.slot & TIMER_WHEEL_SLOT_MASK;
+  if (nullptr == _slotList[level][slot]) { _slotUsed[level] &= ~(1ull << slot); }
+}
+
+void TimerWheel::slotCascade(const uint32_t& level) {
+  const uint32_t slot = (_currTick >> (TIMER_WHEEL_SLOT_BIT * level)) & TIMER_WHEEL_SLOT_MASK;
+  TimerWheelEntry* entry = _slotList[level][slot];
+  _slotList[level][slot] = nullptr;
+  _slotUsed[level] &= ~(1ull << slot);
+
+  // every entry of the slot expires within the turn of the level below that starts now
+  while (entry) {
+    TimerWheelEntry* nextEntry = entry->next;
+    slotInsert(*entry);
+    entry = nextEntry;
+  }
+}
+
+void TimerWheel::add(TimerWheelEntry&         entry,
+                     const uint64_t&          expireTick,
+                     const uint64_t&          periodTick,
+                     const TimerWheelCallback callback,
+                     void*                    context) {
+  assert(callback);
+  if (isArmed(entry)) {
+    slotRemove(entry);
+  } else {
+    ++_totalArmed;
+  }
+
+  // the slot of the current tick has already been run
+  entry.expireTick = (expireTick > _currTick) ? expireTick : (_currTick + 1);
+  entry.periodTick = periodTick;
+  entry.callback   = callback;
+  entry.context    = context;
+  slotInsert(entry);
+}
+
+void TimerWheel::cancel(TimerWheelEntry& entry) {
+  if (!isArmed(entry)) { return; }
+  slotRemove(entry);
+  --_totalArmed;
+}
+
+void TimerWheel::restart(const uint64_t& tick) {
+  assert(0 == _totalArmed);
+  _currTick = tick;
+}
+
+void TimerWheel::advance(const uint64_t& tick) {
+  uint64_t nextTick = 0;
+  while (nextTickGet(nextTick) && (nextTick <= tick)) {
+    // nothing is in the slots skipped over
+    _currTick = nextTick;
+
+    // upper levels first so an entry can fall all the way down to the slot being run
+    for (uint32_t level = TIMER_WHEEL_LEVEL - 1; level > 0; --level) {
+      const uint64_t levelTurnMask = (1ull << (TIMER_WHEEL_SLOT_BIT * level)) - 1;
+      if (0 == (_currTick & levelTurnMask)) { slotCascade(level); }
+    }
+
+    const uint32_t slot = _currTick & TIMER_WHEEL_SLOT_MASK;
+    _dueList            = _slotList[0][slot];
+    if (nullptr == _dueList) { continue; }
+    _slotList[0][slot] = nullptr;
+    _slotUsed[0] &= ~(1ull << slot);
+    _dueList->prevNext = &_dueList;
+    for (TimerWheelEntry* entry = _dueList; entry; entry = entry->next) {
+      entry->slot = TIMER_WHEEL_DUE_SLOT;
+    }
+
+    while (_dueList) {
+      TimerWheelEntry& entry = *_dueList;
+      slotRemove(entry);
+      if (0 != entry.periodTick) {
+        // keep the period from drifting, unless the wheel is so late that it's already passed
+        entry.expireTick += entry.periodTick;
+        if (entry.expireTick <= _currTick) { entry.expireTick = _currTick + 1; }
+        slotInsert(entry);
+      } else {
+        --_totalArmed;
+      }
+      entry.callback(entry.context);
+    }
+  }
+
+  if (tick > _currTick) { _currTick = tick; }
+}
+
+bool TimerWheel::nextTickGet(uint64_t& tick) {
+  bool isFound = false;
+  for (uint32_t level = 0; level < TIMER_WHEEL_LEVEL; ++level) {
+    if (0 == _slotUsed[level]) { continue; }
+
+    // a slot is reached at the start of its turn of the level below
+    const uint32_t shift        = TIMER_WHEEL_SLOT_BIT * level;
+    const uint64_t nextTurnTick = ((_currTick >> shift) + 1) << shift;
+    const uint32_t nextSlot     = (nextTurnTick >> shift) & TIMER_WHEEL_SLOT_MASK;
+    const uint64_t slotTick =
+        nextTurnTick +
+        ((uint64_t)lowestBitGet(rotateRight(_slotUsed[level], nextSlot)) << shift);
+    if (!isFound || (slotTick < tick)) { tick = slotTick; }
+    isFound = true;
+  }
+  return isFound;
+}
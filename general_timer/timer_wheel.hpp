@@ -0,0 +1,71 @@
+#ifndef _TIMER_WHEEL_HPP
+#define _TIMER_WHEEL_HPP
+
+#include <cinttypes>
+
+// levels of the wheel, each one has TIMER_WHEEL_SLOT slots that each span a whole turn of the level
+// below, timeouts further away than the top level can reach wait there and get put back
+static const uint32_t TIMER_WHEEL_LEVEL     = 4;
+static const uint32_t TIMER_WHEEL_SLOT_BIT  = 6;
+static const uint32_t TIMER_WHEEL_SLOT      = 1 << TIMER_WHEEL_SLOT_BIT;
+static const uint32_t TIMER_WHEEL_SLOT_MASK = TIMER_WHEEL_SLOT - 1;
+
+typedef void (*TimerWheelCallback)(void* context);
+
+// one timeout, owned by the caller and only changed through TimerWheel while it's armed
+typedef struct TimerWheelEntry {
+  struct TimerWheelEntry*  next;
+  struct TimerWheelEntry** prevNext;  // pointer that points at this entry, nullptr if not armed
+  uint32_t                 slot;      // level * TIMER_WHEEL_SLOT + slot in the level
+  uint64_t                 expireTick;
+  uint64_t                 periodTick;  // 0 for one shot
+  TimerWheelCallback       callback;
+  void*                    context;
+} TimerWheelEntry;
+
+// hierarchical timer wheel, doesn't know about any timer so the caller feeds it the current tick
+// adding and cancelling is O(1), advancing only visits the slots that have something in them
+// one context may use it at a time, the callbacks run from inside advance()
+class TimerWheel {
+ private:
+  TimerWheelEntry* _slotList[TIMER_WHEEL_LEVEL][TIMER_WHEEL_SLOT];
+  uint64_t         _slotUsed[TIMER_WHEEL_LEVEL];  // bit per slot that isn't empty
+  TimerWheelEntry* _dueList;  // entries of the slot being run, cancel still works on them
+  uint64_t         _currTick;
+  uint32_t         _totalArmed;
+
+  void slotInsert(TimerWheelEntry& entry);
+  void slotRemove(TimerWheelEntry& entry);
+  void slotCascade(const uint32_t& level);
+
+ public:
+  TimerWheel();
+
+  // arm an entry to run callback at expireTick then every periodTick if it's not 0, an entry that
+  // is already armed is moved, a tick that already passed runs on the next advance()
+  void add(TimerWheelEntry&         entry,
+           const uint64_t&          expireTick,
+           const uint64_t&          periodTick,
+           const TimerWheelCallback callback,
+           void*                    context);
+
+  // disarm an entry, does nothing if it isn't armed, safe from a callback
+  void cancel(TimerWheelEntry& entry);
+
+  static bool isArmed(const TimerWheelEntry& entry) { return nullptr != entry.prevNext; }
+
+  // move an empty wheel to tick, even back, so entries added next are placed from there
+  void restart(const uint64_t& tick);
+
+  // run every entry expiring up to tick, periodic ones are armed again b4 their callback runs
+  void advance(const uint64_t& tick);
+
+  // tick when advance() has to be called next, that's the earliest expiry or a slot of an upper
+  // level that has to move down, false if nothing is armed
+  bool nextTickGet(uint64_t& tick);
+
+  uint64_t currTickGet(void) { return _currTick; }
+  uint32_t totalArmedGet(void) { return _totalArmed; }
+};
+
+#endif
@@ -0,0 +1,317 @@
+/**
+ * @brief behavioral model of the HD44780/1602 lcd controller, covers the 4/8 bit interface, DDRAM,
+ * CGRAM, the address counter, busy flag and the execution time of every instruction
+ *
+ * @file hd44780_sim.cpp
+ * @author Khoi Trinh
+ * @date 2018-09-23
+ */
+
+// only part of the host build
+#ifdef LCD_HOST_SIM
+
+#include "hd44780_sim.hpp"
+
+#include <cstring>
+
+namespace tivasim {
+
+// execution time from the datasheet, 270 kHz oscillator
+static const uint64_t POWER_ON_BUSY_NANOSEC    = 40000000;
+static const uint64_t FIRST_STARTUP_NANOSEC    = 4100000;
+static const uint64_t SECOND_STARTUP_NANOSEC   = 100000;
+static const uint64_t INSTRUCTION_EXEC_NANOSEC = 37000;
+static const uint64_t CLEAR_EXEC_NANOSEC       = 1520000;
+static const uint64_t RAM_ACCESS_EXEC_NANOSEC  = 41000;  // 37 us + address counter update
+
+// DDRAM layout in 2 lines mode
+static const uint8_t FIRST_LINE_END   = 0x27;
+static const uint8_t SECOND_LINE_BEGIN = 0x40;
+static const uint8_t SECOND_LINE_END  = 0x67;
+static const uint8_t SINGLE_LINE_END  = 0x4f;
+
+Hd44780Sim::Hd44780Sim(const SimWiring &wiring) : _wiring(wiring) {
+  _timing.pulseWidth     = 230;
+  _timing.minCycleTime   = 500;
+  _timing.addrSetupTime  = 40;
+  _timing.dataSetupTime  = 80;
+  _timing.isTimingStrict = false;
+  powerOn();
+}
+
+void Hd44780Sim::timingSet(const SimTiming &timing) { _timing = timing; }
+
+void Hd44780Sim::powerOn(void) {
+  memset(_ddram, 0x20, sizeof(_ddram));
+  memset(_cgram, 0, sizeof(_cgram));
+  _addrCounter      = 0;
+  _isCgramSelected  = false;
+  _isIncrement      = true;
+  _is8BitMode       = true;
+  _is2Lines         = false;
+  _isDisplayOn      = false;
+  _isCursorOn       = false;
+  _isCursorBlink    = false;
+  _busyUntil        = simTimeGet() + POWER_ON_BUSY_NANOSEC;
+  _isHighNibbleNext = true;
+  _pendingByte      = 0;
+  _isStrobeCorrupt  = false;
+  _lastEnable       = false;
+  _lastRegSelect    = false;
+  _lastReadWrite    = false;
+  _lastData         = 0;
+  _enRiseTime       = 0;
+  _enFallTime       = 0;
+  _addrChangeTime   = 0;
+  _dataChangeTime   = 0;
+  _readOutput       = 0;
+  _isReadHighNibble = true;
+  _isReadCorrupt    = false;
+  _startupCount     = 0;
+  _stat             = Hd44780Stat();
+}
+
+bool Hd44780Sim::pinGet(const SimPin &pin) {
+  // control pins that the TivaC doesn't drive are treated as pulled low
+  if (0 == pin.portBase || !simPinIsOutput(pin.portBase, pin.pinMask)) { return false; }
+  return simPinLevelGet(pin.portBase, pin.pinMask);
+}
+
+uint32_t Hd44780Sim::dataGet(void) {
+  uint32_t data = 0;
+  for (uint32_t pin = 0; pin < _wiring.dataPinCount; ++pin) {
+    const SimPin &dataPin = _wiring.dataPinList[pin];
+    if (simPinIsOutput(dataPin.portBase, dataPin.pinMask) &&
+        simPinLevelGet(dataPin.portBase, dataPin.pinMask)) {
+      data |= 1 << pin;
+    }
+  }
+  // with only 4 pins wired they are D4-D7, D0-D3 are left floating low
+  return (4 == _wiring.dataPinCount) ? (data << 4) : data;
+}
+
+void Hd44780Sim::busySet(const uint64_t &timeNanoSec, const uint64_t &execTime) {
+  _busyUntil = timeNanoSec + execTime;
+}
+
+void Hd44780Sim::addrCounterStep(void) {
+  if (_isCgramSelected) {
+    _addrCounter = (_addrCounter + (_isIncrement ? 1 : -1)) & 0x3f;
+    return;
+  }
+
+  if (_is2Lines) {
+    if (_isIncrement) {
+      if (FIRST_LINE_END == _addrCounter) {
+        _addrCounter = SECOND_LINE_BEGIN;
+      } else if (SECOND_LINE_END == _addrCounter) {
+        _addrCounter = 0;
+      } else {
+        ++_addrCounter;
+      }
+    } else {
+      if (SECOND_LINE_BEGIN == _addrCounter) {
+        _addrCounter = FIRST_LINE_END;
+      } else if (0 == _addrCounter) {
+        _addrCounter = SECOND_LINE_END;
+      } else {
+        --_addrCounter;
+      }
+    }
+  } else {
+    if (_isIncrement) {
+      _addrCounter = (SINGLE_LINE_END == _addrCounter) ? 0 : _addrCounter + 1;
+    } else {
+      _addrCounter = (0 == _addrCounter) ? SINGLE_LINE_END : _addrCounter - 1;
+    }
+  }
+}
+
+void Hd44780Sim::instructionExecute(const uint64_t &timeNanoSec, const uint8_t &instruction) {
+  ++_stat.instructionWrite;
+  uint64_t execTime = INSTRUCTION_EXEC_NANOSEC;
+
+  if (instruction & 0x80) {
+    _addrCounter     = instruction & 0x7f;
+    _isCgramSelected = false;
+  } else if (instruction & 0x40) {
+    _addrCounter     = instruction & 0x3f;
+    _isCgramSelected = true;
+  } else if (instruction & 0x20) {
+    if (_is8BitMode) {
+      // the 3 startup function sets take longer
+      if (0 == _startupCount) {
+        execTime = FIRST_STARTUP_NANOSEC;
+      } else if (1 == _startupCount) {
+        execTime = SECOND_STARTUP_NANOSEC;
+      }
+      ++_startupCount;
+    }
+    const bool is8BitMode = instruction & 0x10;
+    if (is8BitMode != _is8BitMode) { _isHighNibbleNext = true; }
+    _is8BitMode = is8BitMode;
+    _is2Lines   = instruction & 0x08;
+  } else if (instruction & 0x10) {
+    // cursor shift, display shift isn't modeled since the driver doesn't use it
+    if (!(instruction & 0x08)) {
+      const bool isIncrement = _isIncrement;
+      _isIncrement           = instruction & 0x04;
+      addrCounterStep();
+      _isIncrement = isIncrement;
+    }
+  } else if (instruction & 0x08) {
+    _isDisplayOn   = instruction & 0x04;
+    _isCursorOn    = instruction & 0x02;
+    _isCursorBlink = instruction & 0x01;
+  } else if (instruction & 0x04) {
+    _isIncrement = instruction & 0x02;
+  } else if (instruction & 0x02) {
+    _addrCounter     = 0;
+    _isCgramSelected = false;
+    execTime         = CLEAR_EXEC_NANOSEC;
+  } else if (instruction & 0x01) {
+    memset(_ddram, 0x20, sizeof(_ddram));
+    _addrCounter     = 0;
+    _isCgramSelected = false;
+    _isIncrement     = true;
+    execTime         = CLEAR_EXEC_NANOSEC;
+  }
+
+  busySet(timeNanoSec, execTime);
+}
+
+void Hd44780Sim::byteExecute(const uint64_t &timeNanoSec, const uint8_t &byte, const bool &isData) {
+  if (timeNanoSec < _busyUntil) {
+    // the real controller ignores anything sent while it's busy
+    ++_stat.busyViolation;
+    return;
+  }
+
+  if (!isData) {
+    instructionExecute(timeNanoSec, byte);
+    return;
+  }
+
+  ++_stat.dataWrite;
+  if (_isCgramSelected) {
+    _cgram[_addrCounter & 0x3f] = byte;
+  } else {
+    _ddram[_addrCounter & 0x7f] = byte;
+  }
+  addrCounterStep();
+  busySet(timeNanoSec, RAM_ACCESS_EXEC_NANOSEC);
+}
+
+void Hd44780Sim::readPrepare(const uint64_t &timeNanoSec) {
+  if (!_isReadHighNibble) { return; }
+
+  if (_lastRegSelect) {
+    if (timeNanoSec < _busyUntil) { ++_stat.busyViolation; }
+    _readOutput = _isCgramSelected ? _cgram[_addrCounter & 0x3f] : _ddram[_addrCounter & 0x7f];
+  } else {
+    _readOutput = ((timeNanoSec < _busyUntil) ? 0x80 : 0) | _addrCounter;
+  }
+}
+
+void Hd44780Sim::readFinish(const uint64_t &timeNanoSec) {
+  if (!_is8BitMode && _isReadHighNibble) {
+    _isReadHighNibble = false;
+    return;
+  }
+  _isReadHighNibble = true;
+
+  if (_lastRegSelect) {
+    ++_stat.dataRead;
+    addrCounterStep();
+    busySet(timeNanoSec, RAM_ACCESS_EXEC_NANOSEC);
+  } else {
+    ++_stat.statusRead;
+  }
+}
+
+void Hd44780Sim::pinChanged(const uint64_t &timeNanoSec) {
+  const bool     enable    = pinGet(_wiring.enablePin);
+  const bool     regSelect = pinGet(_wiring.regSelectPin);
+  const bool     readWrite = pinGet(_wiring.readWritePin);
+  const uint32_t data      = dataGet();
+
+  if ((regSelect != _lastRegSelect) || (readWrite != _lastReadWrite)) {
+    _addrChangeTime = timeNanoSec;
+  }
+  if ((data != _lastData) && !readWrite) { _dataChangeTime = timeNanoSec; }
+  _lastRegSelect = regSelect;
+  _lastReadWrite = readWrite;
+  _lastData      = data;
+
+  if (enable && !_lastEnable) {
+    // rising edge
+    if (((0 != _stat.enStrobe) && (timeNanoSec - _enRiseTime < _timing.minCycleTime)) ||
+        (timeNanoSec - _addrChangeTime < _timing.addrSetupTime)) {
+      _isStrobeCorrupt = true;
+    }
+    _enRiseTime    = timeNanoSec;
+    _isReadCorrupt = _isStrobeCorrupt && _timing.isTimingStrict;
+    if (readWrite) { readPrepare(timeNanoSec); }
+  } else if (!enable && _lastEnable) {
+    // falling edge, this is where the controller latches the data
+    ++_stat.enStrobe;
+    _enFallTime = timeNanoSec;
+    if ((timeNanoSec - _enRiseTime < _timing.pulseWidth) ||
+        (!readWrite && (timeNanoSec - _dataChangeTime < _timing.dataSetupTime))) {
+      _isStrobeCorrupt = true;
+    }
+
+    const bool isCorrupt = _isStrobeCorrupt;
+    if (isCorrupt) { ++_stat.timingViolation; }
+    _isStrobeCorrupt = false;
+
+    if (readWrite) {
+      readFinish(timeNanoSec);
+    } else {
+      // a strobe that is too fast latches garbage
+      const uint8_t nibble =
+          ((data >> 4) & 0xf) ^ ((isCorrupt && _timing.isTimingStrict) ? 0xf : 0);
+      if (_is8BitMode) {
+        uint8_t byte = data;
+        if (isCorrupt && _timing.isTimingStrict) { byte = ~byte; }
+        byteExecute(timeNanoSec, byte, regSelect);
+      } else if (_isHighNibbleNext) {
+        _pendingByte      = nibble << 4;
+        _isHighNibbleNext = false;
+      } else {
+        _isHighNibbleNext = true;
+        byteExecute(timeNanoSec, _pendingByte | nibble, regSelect);
+      }
+    }
+  }
+  _lastEnable = enable;
+}
+
+uint8_t Hd44780Sim::pinDrive(const uint32_t &portBase) {
+  if (!pinGet(_wiring.enablePin) || !pinGet(_wiring.readWritePin)) { return 0; }
+
+  uint8_t output = _readOutput ^ (_isReadCorrupt ? 0xff : 0);
+  if (!_is8BitMode && !_isReadHighNibble) { output <<= 4; }
+
+  uint8_t result = 0;
+  for (uint32_t pin = 0; pin < _wiring.dataPinCount; ++pin) {
+    const uint32_t dataBit = (4 == _wiring.dataPinCount) ? pin + 4 : pin;
+    const SimPin & dataPin = _wiring.dataPinList[pin];
+    if ((dataPin.portBase == portBase) && (output & (1 << dataBit))) { result |= dataPin.pinMask; }
+  }
+  return result;
+}
+
+std::string Hd44780Sim::rowGet(const uint32_t &totalColumn, const uint8_t &rowOffset) {
+  std::string row;
+  for (uint32_t column = 0; column < totalColumn; ++column) {
+    const uint8_t character = _ddram[(rowOffset + column) & 0x7f];
+    // custom characters are shown as their slot number
+    row += (character < 0x10) ? (char)('0' + (character & 0x7)) : (char)character;
+  }
+  return row;
+}
+
+}  // namespace tivasim
+
+#endif
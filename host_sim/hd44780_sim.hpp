@@ -0,0 +1,162 @@
+/**
+ * @brief behavioral model of the HD44780/1602 lcd controller, it watches the simulated GPIO pins and
+ * reacts to them the same way the real controller does
+ *
+ * @file hd44780_sim.hpp
+ * @author Khoi Trinh
+ * @date 2018-09-23
+ */
+
+#ifndef _HD44780_SIM_HPP
+#define _HD44780_SIM_HPP
+
+#include <cstdint>
+#include <string>
+
+#include "tiva_sim.hpp"
+
+namespace tivasim {
+
+/**
+ * @brief a single pin that the model is hooked up to
+ */
+typedef struct {
+  uint32_t portBase;  //!< port of the pin like GPIO_PORTB_BASE, 0 if not connected
+  uint8_t  pinMask;   //!< the pin like GPIO_PIN_6
+} SimPin;
+
+/**
+ * @brief how the model is wired to the TivaC
+ */
+typedef struct {
+  SimPin   regSelectPin;  //!< RS
+  SimPin   readWritePin;  //!< R/W, leave port as 0 if R/W is tied low
+  SimPin   enablePin;     //!< EN
+  SimPin   dataPinList[8];  //!< D0-D7 if dataPinCount is 8, otherwise D4-D7 in the first 4
+  uint32_t dataPinCount;  //!< 4 or 8
+} SimWiring;
+
+/**
+ * @brief minimum timing that the model accepts, a strobe that violates them is counted and if
+ * isTimingStrict is set the strobe latches or drives garbage like a real controller that can't keep
+ * up
+ */
+typedef struct {
+  uint64_t pulseWidth;     //!< EN high time
+  uint64_t minCycleTime;   //!< time between 2 EN rising edge
+  uint64_t addrSetupTime;  //!< RS, R/W stable b4 EN rises
+  uint64_t dataSetupTime;  //!< data stable b4 EN falls
+  bool     isTimingStrict;  //!< drop strobes violating the timing
+} SimTiming;
+
+/**
+ * @brief counters of what the model saw
+ */
+typedef struct {
+  uint64_t enStrobe;          //!< falling edges of EN
+  uint64_t instructionWrite;  //!< full instruction bytes written
+  uint64_t dataWrite;         //!< full data bytes written
+  uint64_t dataRead;          //!< full data bytes read
+  uint64_t statusRead;        //!< full busy flag reads
+  uint64_t busyViolation;     //!< bytes written while the controller was still busy, they are lost
+  uint64_t timingViolation;   //!< strobes that broke the timing in SimTiming
+} Hd44780Stat;
+
+/**
+ * @brief the lcd controller model
+ */
+class Hd44780Sim : public PinListener {
+ private:
+  SimWiring   _wiring;
+  SimTiming   _timing;
+  Hd44780Stat _stat;
+
+  uint8_t _ddram[128];
+  uint8_t _cgram[64];
+  uint8_t _addrCounter;
+  bool    _isCgramSelected;
+  bool    _isIncrement;
+  bool    _is8BitMode;
+  bool    _is2Lines;
+  bool    _isDisplayOn;
+  bool    _isCursorOn;
+  bool    _isCursorBlink;
+
+  uint64_t _busyUntil;
+  bool     _isHighNibbleNext;  // 4 bit mode, true when the next nibble is the high one
+  uint8_t  _pendingByte;
+  bool     _isStrobeCorrupt;  // a nibble of the current byte was dropped
+
+  // pin history for edge and timing detection
+  bool     _lastEnable;
+  bool     _lastRegSelect;
+  bool     _lastReadWrite;
+  uint32_t _lastData;
+  uint64_t _enRiseTime;
+  uint64_t _enFallTime;
+  uint64_t _addrChangeTime;
+  uint64_t _dataChangeTime;
+  uint8_t  _readOutput;  // byte being read out
+  bool     _isReadHighNibble;
+  bool     _isReadCorrupt;  // the current read strobe came too early, garbage is driven
+  uint32_t _startupCount;  // function sets received in 8 bit mode
+
+  bool     pinGet(const SimPin &pin);
+  uint32_t dataGet(void);
+  void     busySet(const uint64_t &timeNanoSec, const uint64_t &execTime);
+  void     byteExecute(const uint64_t &timeNanoSec, const uint8_t &byte, const bool &isData);
+  void     instructionExecute(const uint64_t &timeNanoSec, const uint8_t &instruction);
+  void     addrCounterStep(void);
+  void     readPrepare(const uint64_t &timeNanoSec);
+  void     readFinish(const uint64_t &timeNanoSec);
+
+ public:
+  /**
+   * @brief Construct a new controller model that just got powered on
+   * @param wiring how the model connects to the simulated pins
+   */
+  Hd44780Sim(const SimWiring &wiring);
+
+  void    pinChanged(const uint64_t &timeNanoSec) override;
+  uint8_t pinDrive(const uint32_t &portBase) override;
+
+  /**
+   * @brief set the minimum timing that the model accepts, default is the datasheet timing with
+   * isTimingStrict off
+   */
+  void timingSet(const SimTiming &timing);
+
+  /**
+   * @brief power cycle the model, all RAM is lost
+   */
+  void powerOn(void);
+
+  /**
+   * @brief get a row of text as the user would see it on the display, custom characters are
+   * shown as their slot number
+   * @param totalColumn how many column the panel has
+   * @param rowOffset DDRAM address of the first character of the row
+   */
+  std::string rowGet(const uint32_t &totalColumn, const uint8_t &rowOffset);
+
+  /**
+   * @brief raw access to the display data RAM
+   */
+  uint8_t ddramGet(const uint8_t &addr) { return _ddram[addr & 0x7f]; }
+
+  /**
+   * @brief raw access to the character generator RAM
+   */
+  uint8_t cgramGet(const uint8_t &addr) { return _cgram[addr & 0x3f]; }
+
+  uint8_t addrCounterGet(void) { return _addrCounter; }
+  bool    isBusy(void) { return simTimeGet() < _busyUntil; }
+  bool    is8BitMode(void) { return _is8BitMode; }
+
+  const Hd44780Stat &statGet(void) { return _stat; }
+  void               statReset(void) { _stat = Hd44780Stat(); }
+};
+
+}  // namespace tivasim
+
+#endif
@@ -0,0 +1,264 @@
+/**
+ * @brief glue between the LcdDriver and the simulated controller
+ *
+ * @file lcd_sim.cpp
+ * @author Khoi Trinh
+ * @date 2018-09-23
+ */
+
+// only part of the host build
+#ifdef LCD_HOST_SIM
+
+#include "lcd_sim.hpp"
+
+#include <cstdio>
+#include <string>
+
+#include "general_timer/general_timer.hpp"
+
+// peripheral
+#include "driverlib/gpio.h"
+#include "driverlib/sysctl.h"
+
+// hardware
+#include "inc/hw_memmap.h"
+
+using namespace lcddriver;
+
+namespace tivasim {
+
+static void pinSet(uint32_t       pinDesc[PIN_DESCRIPTION_LEN],
+                   const uint32_t &clock,
+                   const uint32_t &port,
+                   const uint32_t &pin) {
+  pinDesc[PIN_DESC_CLOCK_INDEX] = clock;
+  pinDesc[PIN_DESC_PORT_INDEX]  = port;
+  pinDesc[PIN_DESC_PIN_INDEX]   = pin;
+}
+
+static SimPin simPinGet(const uint32_t pinDesc[PIN_DESCRIPTION_LEN]) {
+  SimPin simPin;
+  simPin.portBase = pinDesc[PIN_DESC_PORT_INDEX];
+  simPin.pinMask  = pinDesc[PIN_DESC_PIN_INDEX];
+  return simPin;
+}
+
+LcdConfig lcdConfigDefaultGet(const LcdPacingMode &pacingMode) {
+  LcdConfig lcdConfig;
+  lcdConfig.useBacklight    = true;
+  lcdConfig.pacingMode      = pacingMode;
+  lcdConfig.isAsync         = false;
+  lcdConfig.isDmaStreamed   = false;
+  lcdConfig.is8BitBus       = false;
+  lcdConfig.isWriteOnly     = false;
+  lcdConfig.geometry        = LCD_GEOMETRY_16X2;
+  lcdConfig.totalController = 1;
+  lcdConfig.isBroadcast     = false;
+  pinSet(lcdConfig.backLightPin, SYSCTL_PERIPH_GPIOB, GPIO_PORTB_BASE, GPIO_PIN_6);
+  pinSet(lcdConfig.regSelectPin, SYSCTL_PERIPH_GPIOB, GPIO_PORTB_BASE, GPIO_PIN_7);
+  pinSet(lcdConfig.readWritePin, SYSCTL_PERIPH_GPIOF, GPIO_PORTF_BASE, GPIO_PIN_4);
+  pinSet(lcdConfig.enablePinList[0], SYSCTL_PERIPH_GPIOE, GPIO_PORTE_BASE, GPIO_PIN_3);
+  pinSet(lcdConfig.parallelPinList[0], SYSCTL_PERIPH_GPIOE, GPIO_PORTE_BASE, GPIO_PIN_2);
+  pinSet(lcdConfig.parallelPinList[1], SYSCTL_PERIPH_GPIOE, GPIO_PORTE_BASE, GPIO_PIN_1);
+  pinSet(lcdConfig.parallelPinList[2], SYSCTL_PERIPH_GPIOE, GPIO_PORTE_BASE, GPIO_PIN_0);
+  pinSet(lcdConfig.parallelPinList[3], SYSCTL_PERIPH_GPIOD, GPIO_PORTD_BASE, GPIO_PIN_6);
+  return lcdConfig;
+}
+
+LcdConfig lcdConfigSinglePortGet(void) {
+  LcdConfig lcdConfig     = lcdConfigDefaultGet(PACING_FIXED_DELAY);
+  lcdConfig.useBacklight  = false;
+  lcdConfig.isAsync       = true;
+  lcdConfig.isDmaStreamed = true;
+  pinSet(lcdConfig.regSelectPin, SYSCTL_PERIPH_GPIOD, GPIO_PORTD_BASE, GPIO_PIN_0);
+  pinSet(lcdConfig.readWritePin, SYSCTL_PERIPH_GPIOD, GPIO_PORTD_BASE, GPIO_PIN_1);
+  pinSet(lcdConfig.enablePinList[0], SYSCTL_PERIPH_GPIOD, GPIO_PORTD_BASE, GPIO_PIN_2);
+  pinSet(lcdConfig.parallelPinList[0], SYSCTL_PERIPH_GPIOD, GPIO_PORTD_BASE, GPIO_PIN_3);
+  pinSet(lcdConfig.parallelPinList[1], SYSCTL_PERIPH_GPIOD, GPIO_PORTD_BASE, GPIO_PIN_4);
+  pinSet(lcdConfig.parallelPinList[2], SYSCTL_PERIPH_GPIOD, GPIO_PORTD_BASE, GPIO_PIN_5);
+  pinSet(lcdConfig.parallelPinList[3], SYSCTL_PERIPH_GPIOD, GPIO_PORTD_BASE, GPIO_PIN_6);
+  return lcdConfig;
+}
+
+LcdConfig lcdConfig8BitGet(const LcdPacingMode &pacingMode) {
+  LcdConfig lcdConfig = lcdConfigDefaultGet(pacingMode);
+  lcdConfig.is8BitBus = true;
+  pinSet(lcdConfig.backLightPin, SYSCTL_PERIPH_GPIOF, GPIO_PORTF_BASE, GPIO_PIN_2);
+  pinSet(lcdConfig.regSelectPin, SYSCTL_PERIPH_GPIOE, GPIO_PORTE_BASE, GPIO_PIN_1);
+  pinSet(lcdConfig.readWritePin, SYSCTL_PERIPH_GPIOE, GPIO_PORTE_BASE, GPIO_PIN_2);
+  pinSet(lcdConfig.enablePinList[0], SYSCTL_PERIPH_GPIOE, GPIO_PORTE_BASE, GPIO_PIN_3);
+  // PB2 and PB3 are reserved so no port has 8 free pins
+  for (uint32_t pin = 0; pin < 4; ++pin) {
+    pinSet(lcdConfig.parallelPinList[pin], SYSCTL_PERIPH_GPIOC, GPIO_PORTC_BASE, GPIO_PIN_4 << pin);
+    pinSet(lcdConfig.parallelPinList[pin + 4],
+           SYSCTL_PERIPH_GPIOB,
+           GPIO_PORTB_BASE,
+           GPIO_PIN_4 << pin);
+  }
+  return lcdConfig;
+}
+
+LcdConfig lcdConfig40x4Get(const LcdPacingMode &pacingMode) {
+  LcdConfig lcdConfig       = lcdConfigDefaultGet(pacingMode);
+  lcdConfig.geometry        = LCD_GEOMETRY_40X4;
+  lcdConfig.totalController = 2;
+  pinSet(lcdConfig.enablePinList[1], SYSCTL_PERIPH_GPIOF, GPIO_PORTF_BASE, GPIO_PIN_2);
+  return lcdConfig;
+}
+
+LcdConfig lcdConfigBroadcastGet(const LcdPacingMode &pacingMode, const uint32_t &totalDisplay) {
+  static const uint8_t ENABLE_PIN_LIST[] = {GPIO_PIN_3, GPIO_PIN_4, GPIO_PIN_5};
+  LcdConfig            lcdConfig         = lcdConfigDefaultGet(pacingMode);
+  lcdConfig.totalController              = totalDisplay;
+  lcdConfig.isBroadcast                  = true;
+  for (uint32_t display = 0; display < totalDisplay; ++display) {
+    if (display < sizeof(ENABLE_PIN_LIST)) {
+      pinSet(lcdConfig.enablePinList[display],
+             SYSCTL_PERIPH_GPIOE,
+             GPIO_PORTE_BASE,
+             ENABLE_PIN_LIST[display]);
+    } else {
+      pinSet(lcdConfig.enablePinList[display], SYSCTL_PERIPH_GPIOF, GPIO_PORTF_BASE, GPIO_PIN_2);
+    }
+  }
+  return lcdConfig;
+}
+
+SimWiring lcdWiringGet(const LcdConfig &lcdConfig) { return lcdWiringGet(lcdConfig, 0); }
+
+SimWiring lcdWiringGet(const LcdConfig &lcdConfig, const uint32_t &controller) {
+  SimWiring wiring = SimWiring();
+  wiring.regSelectPin = simPinGet(lcdConfig.regSelectPin);
+  // an unconnected R/W reads as tied low
+  if (!lcdConfig.isWriteOnly) { wiring.readWritePin = simPinGet(lcdConfig.readWritePin); }
+  wiring.enablePin    = simPinGet(lcdConfig.enablePinList[controller]);
+  wiring.dataPinCount = lcdConfig.is8BitBus ? 8 : 4;
+  for (uint32_t pin = 0; pin < wiring.dataPinCount; ++pin) {
+    wiring.dataPinList[pin] = simPinGet(lcdConfig.parallelPinList[pin]);
+  }
+  return wiring;
+}
+
+uint64_t lcdTransactionGet(const LcdConfig &lcdConfig) {
+  const SimPin regSelectPin = simPinGet(lcdConfig.regSelectPin);
+  return simPinWriteGet(regSelectPin.portBase, regSelectPin.pinMask);
+}
+
+uint64_t lcdDataStoreGet(const LcdConfig &lcdConfig) {
+  // data pins are grouped by port like the driver does
+  uint32_t       portBaseList[TOTAL_PARALLEL_PIN];
+  uint8_t        pinMaskList[TOTAL_PARALLEL_PIN];
+  uint32_t       totalPort = 0;
+  const uint32_t totalPin  = lcdConfig.is8BitBus ? 8 : 4;
+  for (uint32_t pin = 0; pin < totalPin; ++pin) {
+    const SimPin simPin = simPinGet(lcdConfig.parallelPinList[pin]);
+    uint32_t     port   = 0;
+    while ((port < totalPort) && (portBaseList[port] != simPin.portBase)) { ++port; }
+    if (port == totalPort) {
+      portBaseList[port] = simPin.portBase;
+      pinMaskList[port]  = 0;
+      ++totalPort;
+    }
+    pinMaskList[port] |= simPin.pinMask;
+  }
+
+  uint64_t dataStore = 0;
+  for (uint32_t port = 0; port < totalPort; ++port) {
+    dataStore += simPinWriteGet(portBaseList[port], pinMaskList[port]);
+  }
+  return dataStore;
+}
+
+void lcdScreenPrint(Hd44780Sim &lcdSim, const LcdGeometry &geometry) {
+  Hd44780Sim *lcdSimList[] = {&lcdSim};
+  lcdScreenPrint(lcdSimList, geometry);
+}
+
+void lcdScreenPrint(Hd44780Sim *const lcdSimList[], const LcdGeometry &geometry) {
+  const std::string border = "+" + std::string(geometry.totalColumn, '-') + "+";
+  printf("%s\n", border.c_str());
+  for (uint32_t row = 0; row < geometry.totalRow; ++row) {
+    Hd44780Sim &lcdSim = *lcdSimList[geometry.rowControllerList[row]];
+    printf("|%s|\n", lcdSim.rowGet(geometry.totalColumn, geometry.rowAddrList[row]).c_str());
+  }
+  printf("%s\n", border.c_str());
+}
+
+std::string lcdScreenGet(Hd44780Sim &lcdSim, const LcdGeometry &geometry) {
+  Hd44780Sim *lcdSimList[] = {&lcdSim};
+  return lcdScreenGet(lcdSimList, geometry);
+}
+
+std::string lcdScreenGet(Hd44780Sim *const lcdSimList[], const LcdGeometry &geometry) {
+  std::string screen;
+  for (uint32_t row = 0; row < geometry.totalRow; ++row) {
+    Hd44780Sim &lcdSim  = *lcdSimList[geometry.rowControllerList[row]];
+    std::string rowText = lcdSim.rowGet(geometry.totalColumn, geometry.rowAddrList[row]);
+    rowText.erase(rowText.find_last_not_of(' ') + 1);
+    screen += (0 == row) ? rowText : "\n" + rowText;
+  }
+  screen.erase(screen.find_last_not_of('\n') + 1);
+  return screen;
+}
+
+static std::vector<Hd44780Sim> lcdSimListCreate(const LcdConfig &lcdConfig) {
+  simReset();
+  simListenerClear();
+  std::vector<Hd44780Sim> lcdSimList;
+  for (uint32_t controller = 0; controller < lcdConfig.totalController; ++controller) {
+    lcdSimList.push_back(Hd44780Sim(lcdWiringGet(lcdConfig, controller)));
+  }
+  return lcdSimList;
+}
+
+LcdSimFixture::LcdSimFixture(const LcdConfig &lcdConfig)
+    : _lcdConfig(lcdConfig), _lcdSimList(lcdSimListCreate(lcdConfig)), _lcdDriver(lcdConfig) {
+  for (uint32_t controller = 0; controller < _lcdConfig.totalController; ++controller) {
+    _lcdSimPtrList[controller] = &_lcdSimList[controller];
+    simListenerAdd(_lcdSimPtrList[controller]);
+  }
+  simTimerIsrSet(TIMER1_BASE, LcdTxTimerIntHandler);
+  simTimerIsrSet(WTIMER0_BASE, GeneralTimerIntHandler);
+  _lcdDriver.init();
+}
+
+void LcdSimFixture::statReset(void) {
+  for (Hd44780Sim &lcdSim : _lcdSimList) { lcdSim.statReset(); }
+  simStatReset();
+  GeneralTimer::statReset();
+}
+
+Hd44780Stat LcdSimFixture::statGet(void) {
+  Hd44780Stat stat = Hd44780Stat();
+  for (Hd44780Sim &lcdSim : _lcdSimList) {
+    const Hd44780Stat &lcdStat = lcdSim.statGet();
+    stat.enStrobe += lcdStat.enStrobe;
+    stat.instructionWrite += lcdStat.instructionWrite;
+    stat.dataWrite += lcdStat.dataWrite;
+    stat.dataRead += lcdStat.dataRead;
+    stat.statusRead += lcdStat.statusRead;
+    stat.busyViolation += lcdStat.busyViolation;
+    stat.timingViolation += lcdStat.timingViolation;
+  }
+  return stat;
+}
+
+std::string LcdSimFixture::screenGet(void) {
+  return lcdScreenGet(_lcdSimPtrList, _lcdConfig.geometry);
+}
+
+void LcdSimFixture::screenPrint(void) { lcdScreenPrint(_lcdSimPtrList, _lcdConfig.geometry); }
+
+static uint32_t checkFail = 0;
+
+void simCheck(const bool &isPassed, const char *context, const char *name) {
+  if (isPassed) { return; }
+  ++checkFail;
+  fprintf(stderr, "check failed: %s: %s\n", context, name);
+}
+
+uint32_t simCheckFailGet(void) { return checkFail; }
+
+}  // namespace tivasim
+
+#endif
@@ -0,0 +1,174 @@
+/**
+ * @brief glue between the LcdDriver and the simulated controller, used by the host programs
+ *
+ * @file lcd_sim.hpp
+ * @author Khoi Trinh
+ * @date 2018-09-23
+ */
+
+#ifndef _LCD_SIM_HPP
+#define _LCD_SIM_HPP
+
+#include <string>
+#include <vector>
+
+#include "hd44780_sim.hpp"
+#include "src/lcd_driver.hpp"
+
+namespace tivasim {
+
+/**
+ * @brief get the pin map used by src/main.cpp, the same one as the dev board
+ * @param pacingMode how the driver should pace the controller
+ */
+lcddriver::LcdConfig lcdConfigDefaultGet(const lcddriver::LcdPacingMode &pacingMode);
+
+/**
+ * @brief get a pin map with every lcd signal on port D, as LcdConfig::isDmaStreamed needs, the
+ * backlight is left out
+ */
+lcddriver::LcdConfig lcdConfigSinglePortGet(void);
+
+/**
+ * @brief get a pin map with an 8 bit bus, D0-D3 on port C and D4-D7 on port B
+ * @param pacingMode how the driver should pace the controller
+ */
+lcddriver::LcdConfig lcdConfig8BitGet(const lcddriver::LcdPacingMode &pacingMode);
+
+/**
+ * @brief get the default pin map for a 40x4, the EN of the second controller is on PF2
+ * @param pacingMode how the driver should pace the controllers
+ */
+lcddriver::LcdConfig lcdConfig40x4Get(const lcddriver::LcdPacingMode &pacingMode);
+
+/**
+ * @brief get the default pin map with LcdConfig::isBroadcast to several 16x2 displays, the EN of
+ * the first 3 are PE3, PE4 and PE5 so they are strobed with one port write, the 4th is on PF2
+ * @param pacingMode how the driver should pace the controllers
+ * @param totalDisplay how many displays, up to LCD_MAX_CONTROLLER
+ */
+lcddriver::LcdConfig lcdConfigBroadcastGet(const lcddriver::LcdPacingMode &pacingMode,
+                                           const uint32_t &               totalDisplay);
+
+/**
+ * @brief wire a controller model the same way the driver is configured
+ * @param lcdConfig the config given to the LcdDriver
+ */
+SimWiring lcdWiringGet(const lcddriver::LcdConfig &lcdConfig);
+
+/**
+ * @brief wire the model of one of the controllers sharing the bus
+ * @param lcdConfig the config given to the LcdDriver
+ * @param controller which EN of lcdConfig the model listens to
+ */
+SimWiring lcdWiringGet(const lcddriver::LcdConfig &lcdConfig, const uint32_t &controller);
+
+/**
+ * @brief get how many transactions the driver started since simStatReset(), each sets up RS first,
+ * with LcdConfig::isWriteOnly that is skipped while RS stays the same so only RS changes count,
+ * uDMA doesn't go through GPIOPinWrite so LcdConfig::isDmaStreamed counts none
+ * @param lcdConfig the config given to the LcdDriver
+ */
+uint64_t lcdTransactionGet(const lcddriver::LcdConfig &lcdConfig);
+
+/**
+ * @brief get how many stores put a value on the data pins since simStatReset(), each GPIOPinWrite
+ * to a port holding data pins counts as one
+ * @param lcdConfig the config given to the LcdDriver
+ */
+uint64_t lcdDataStoreGet(const lcddriver::LcdConfig &lcdConfig);
+
+/**
+ * @brief print what the display shows with a frame around it
+ * @param lcdSim the controller model
+ * @param geometry the geometry given to the LcdDriver
+ */
+void lcdScreenPrint(Hd44780Sim &lcdSim, const lcddriver::LcdGeometry &geometry);
+
+/**
+ * @brief print what a display with several controllers shows
+ * @param lcdSimList a model per controller, indexed like LcdGeometry::rowControllerList
+ * @param geometry the geometry given to the LcdDriver
+ */
+void lcdScreenPrint(Hd44780Sim *const lcdSimList[], const lcddriver::LcdGeometry &geometry);
+
+/**
+ * @brief get what the display shows as text, rows are split by a newline and lose their trailing
+ * spaces, empty rows at the end are left out, so it can be compared with what was given to
+ * displayWrite()
+ * @param lcdSim the controller model
+ * @param geometry the geometry given to the LcdDriver
+ */
+std::string lcdScreenGet(Hd44780Sim &lcdSim, const lcddriver::LcdGeometry &geometry);
+
+/**
+ * @brief get what a display with several controllers shows as text
+ * @param lcdSimList a model per controller, indexed like LcdGeometry::rowControllerList
+ * @param geometry the geometry given to the LcdDriver
+ */
+std::string lcdScreenGet(Hd44780Sim *const lcdSimList[], const lcddriver::LcdGeometry &geometry);
+
+/**
+ * @brief a LcdDriver wired to a controller model per EN of its config on a freshly reset simulator,
+ * the driver is init() but not enable()d yet so the timing of the models can still be changed, the
+ * timer interrupts of the async mode and of GeneralTimer are hooked up
+ */
+class LcdSimFixture {
+ private:
+  lcddriver::LcdConfig    _lcdConfig;
+  std::vector<Hd44780Sim> _lcdSimList;  //!< never grows once the simulator points at its models
+  Hd44780Sim *            _lcdSimPtrList[lcddriver::LCD_MAX_CONTROLLER];
+  lcddriver::LcdDriver    _lcdDriver;
+
+ public:
+  /**
+   * @brief reset the simulator and set up the models and the driver
+   * @param lcdConfig the config given to the LcdDriver, a model is wired to each of its EN
+   */
+  LcdSimFixture(const lcddriver::LcdConfig &lcdConfig);
+
+  lcddriver::LcdDriver &driverGet(void) { return _lcdDriver; }
+
+  /**
+   * @brief get the model wired to an EN of the config
+   */
+  Hd44780Sim &lcdSimGet(const uint32_t &controller) { return *_lcdSimPtrList[controller]; }
+
+  /**
+   * @brief reset the counters of the models, of the simulator and of GeneralTimer
+   */
+  void statReset(void);
+
+  /**
+   * @brief get the counters of all the models added up
+   */
+  Hd44780Stat statGet(void);
+
+  /**
+   * @brief get what the display shows as text, like lcdScreenGet()
+   */
+  std::string screenGet(void);
+
+  /**
+   * @brief print what the display shows with a frame around it
+   */
+  void screenPrint(void);
+};
+
+/**
+ * @brief count a failed check of a host program and print which one to stderr, main() returns
+ * nonzero when simCheckFailGet() isn't 0 so make stops on it
+ * @param isPassed the checked condition
+ * @param context the demo or workload that ran, like its heading
+ * @param name what was checked
+ */
+void simCheck(const bool &isPassed, const char *context, const char *name);
+
+/**
+ * @brief get how many simCheck() failed so far
+ */
+uint32_t simCheckFailGet(void);
+
+}  // namespace tivasim
+
+#endif
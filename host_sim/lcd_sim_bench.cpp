@@ -0,0 +1,320 @@
+/**
+ * @brief times every public LcdDriver API over a fixed set of workloads on the simulator and prints
+ * the results as JSON, so two builds of the driver can be compared number by number, given the
+ * path of an earlier output it also fails when a run got slower than in it
+ *
+ * @file lcd_sim_bench.cpp
+ * @author Khoi Trinh
+ * @date 2018-09-23
+ */
+
+// only part of the host build
+#ifdef LCD_HOST_SIM
+
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "general_timer/general_timer.hpp"
+#include "lcd_sim.hpp"
+#include "tiva_sim.hpp"
+
+// hardware
+#include "inc/hw_memmap.h"
+
+using namespace lcddriver;
+using namespace tivasim;
+
+/**
+ * @brief one way of configuring the driver that every workload is run with
+ */
+typedef struct {
+  const char *name;
+  LcdConfig   lcdConfig;
+  uint64_t    sleepWaitMin;  //!< nanosec from which GeneralTimer waits sleep, 0 to always spin
+} BenchMode;
+
+/**
+ * @brief a workload, prepare() brings the driver to the starting state and isn't measured
+ */
+typedef struct {
+  const char *name;
+  bool        isEnabled;  //!< whether enable() is called b4 prepare(), false to measure enable()
+  void (*prepare)(LcdDriver &lcdDriver);  //!< nullptr to run right after enable()
+  void (*run)(LcdDriver &lcdDriver);
+} BenchCase;
+
+static uint8_t benchCharPattern[CUSTOM_CHAR_PATTERN_LEN] = {
+    0b11111, 0b11000, 0b10100, 0b10111, 0b10101, 0b10101, 0b10101, 0b11111};
+
+static void prepareDashboard(LcdDriver &lcdDriver) {
+  lcdDriver.displayWrite("Temp: 23.5 C\nHumidity: 45 %");
+}
+
+static void prepareFullScreen(LcdDriver &lcdDriver) {
+  lcdDriver.displayWrite("abcdefghijklmnop\nqrstuvwxyz01234");
+}
+
+static void runEnable(LcdDriver &lcdDriver) { lcdDriver.enable(); }
+
+static void runFullScreen(LcdDriver &lcdDriver) {
+  lcdDriver.displayWrite("ABCDEFGHIJKLMNOP\nQRSTUVWXYZ56789");
+}
+
+static void runDigitUpdate(LcdDriver &lcdDriver) {
+  lcdDriver.displayWrite("Temp: 23.6 C\nHumidity: 45 %");
+}
+
+static void runAppend(LcdDriver &lcdDriver) { lcdDriver.displayAppend(" 42"); }
+
+static void runAppendRun(LcdDriver &lcdDriver) { lcdDriver.displayAppend("ab `2c\td\nxyz"); }
+
+static void runCustomCharUpload(LcdDriver &lcdDriver) {
+  for (uint32_t slot = 0; slot < 8; ++slot) { lcdDriver.newCustomCharAdd(benchCharPattern, slot); }
+}
+
+static void runCursorChange(LcdDriver &lcdDriver) { lcdDriver.cursorPositionChange(5, 1); }
+
+static void runSettingSwitch(LcdDriver &lcdDriver) { lcdDriver.lcdSettingSwitch(true, true, true); }
+
+static const BenchCase benchCaseList[] = {
+    {"enable_cold", false, nullptr, runEnable},
+    {"display_write_full_screen", true, prepareFullScreen, runFullScreen},
+    {"display_write_digit_update", true, prepareDashboard, runDigitUpdate},
+    {"display_append", true, prepareDashboard, runAppend},
+    {"display_append_runs", true, nullptr, runAppendRun},
+    {"custom_char_upload_8", true, nullptr, runCustomCharUpload},
+    {"cursor_position_change", true, prepareDashboard, runCursorChange},
+    {"lcd_setting_switch", true, nullptr, runSettingSwitch}};
+
+/**
+ * @brief how much a number of a run can go over the baseline, the simulator is deterministic so
+ * it only leaves room for changes that are meant to trade a little time for something else
+ */
+static const uint64_t BENCH_TOLERANCE_PERCENT = 2;
+
+/**
+ * @brief the numbers of a run that can't grow past the baseline
+ */
+static const char *const BENCH_CHECKED_FIELD_LIST[] = {
+    "bus_time_ns", "return_time_ns", "transactions", "gpio_calls", "data_stores", "en_strobes",
+    "wait_calls"};
+
+static std::vector<std::string> benchBaselineList;  //!< JSON line of every run of the baseline
+
+static bool benchFieldGet(const char *line, const char *field, uint64_t &value) {
+  char key[64];
+  snprintf(key, sizeof(key), "\"%s\": ", field);
+  const char *valueText = strstr(line, key);
+  if (!valueText) { return false; }
+  value = strtoull(valueText + strlen(key), nullptr, 10);
+  return true;
+}
+
+/**
+ * @brief read the runs of an earlier bench output, one JSON object per line
+ * @return false if the file can't be read or has no run in it
+ */
+static bool benchBaselineLoad(const char *path) {
+  FILE *file = fopen(path, "r");
+  if (!file) { return false; }
+  char line[1024];
+  while (fgets(line, sizeof(line), file)) {
+    if (strstr(line, "\"mode\": ")) { benchBaselineList.push_back(line); }
+  }
+  fclose(file);
+  return !benchBaselineList.empty();
+}
+
+/**
+ * @brief compare a run with the same mode and case in the baseline
+ * @param runId "mode": "<mode>", "case": "<case>" as it starts the JSON line
+ */
+static void benchBaselineCheck(const char *line, const char *runId) {
+  const std::string *baseline = nullptr;
+  for (const std::string &baselineLine : benchBaselineList) {
+    if (strstr(baselineLine.c_str(), runId)) {
+      baseline = &baselineLine;
+      break;
+    }
+  }
+  simCheck(baseline, runId, "in the baseline");
+  if (!baseline) { return; }
+
+  for (const char *field : BENCH_CHECKED_FIELD_LIST) {
+    uint64_t value         = 0;
+    uint64_t baselineValue = 0;
+    if (!benchFieldGet(line, field, value) ||
+        !benchFieldGet(baseline->c_str(), field, baselineValue)) {
+      continue;
+    }
+    char name[128];
+    snprintf(name,
+             sizeof(name),
+             "%s %" PRIu64 " over the baseline %" PRIu64,
+             field,
+             value,
+             baselineValue);
+    simCheck(value * 100 <= baselineValue * (100 + BENCH_TOLERANCE_PERCENT), runId, name);
+  }
+}
+
+static void benchCaseRun(const BenchMode &benchMode, const BenchCase &benchCase, bool isFirst) {
+  simReset();
+  simListenerClear();
+  Hd44780Sim lcdSim(lcdWiringGet(benchMode.lcdConfig));
+  simListenerAdd(&lcdSim);
+  simTimerIsrSet(TIMER1_BASE, LcdTxTimerIntHandler);
+  simTimerIsrSet(WTIMER0_BASE, GeneralTimerIntHandler);
+  GeneralTimer(UNIT_NANOSEC).sleepWaitSet(benchMode.sleepWaitMin);
+
+  LcdDriver lcdDriver(benchMode.lcdConfig);
+  lcdDriver.init();
+  if (benchCase.isEnabled) { lcdDriver.enable(); }
+  if (benchCase.prepare) { benchCase.prepare(lcdDriver); }
+  lcdDriver.flush();
+
+  lcdSim.statReset();
+  simStatReset();
+  GeneralTimer::statReset();
+  const uint64_t startTime = simTimeGet();
+  benchCase.run(lcdDriver);
+  const uint64_t returnTime = simTimeGet() - startTime;
+  lcdDriver.flush();
+  const uint64_t busTime = simTimeGet() - startTime;
+
+  const SimStat &         simStat   = simStatGet();
+  const Hd44780Stat &     lcdStat   = lcdSim.statGet();
+  const GeneralTimerStat &timerStat = GeneralTimer::statGet();
+  char                    runId[128];
+  char                    line[1024];
+  snprintf(runId,
+           sizeof(runId),
+           "\"mode\": \"%s\", \"case\": \"%s\"",
+           benchMode.name,
+           benchCase.name);
+  snprintf(line,
+           sizeof(line),
+           "{%s, \"bus_time_ns\": %" PRIu64 ", \"return_time_ns\": %" PRIu64
+           ", \"transactions\": %" PRIu64 ", \"gpio_calls\": %" PRIu64 ", \"data_stores\": %" PRIu64
+           ", \"en_strobes\": %" PRIu64 ", \"wait_calls\": %" PRIu64 ", \"wait_time_ns\": %" PRIu64
+           ", \"interrupts\": %" PRIu64 ", \"sleep_ns\": %" PRIu64 ", \"sleep_waits\": %" PRIu64
+           ", \"wake_late_max_ns\": %" PRIu64 ", \"busy_violations\": %" PRIu64
+           ", \"timing_violations\": %" PRIu64 "}",
+           runId,
+           busTime,
+           returnTime,
+           lcdTransactionGet(benchMode.lcdConfig),
+           simStat.gpioWriteCall + simStat.gpioReadCall + simStat.gpioDirCall,
+           lcdDataStoreGet(benchMode.lcdConfig),
+           lcdStat.enStrobe,
+           timerStat.waitCall,
+           timerStat.waitTick * 1000 / (SIM_CLOCK_HZ / 1000000),
+           simStat.interruptCall,
+           simStat.sleepTime,
+           timerStat.sleepCall,
+           timerStat.wakeLateTickMax * 1000 / (SIM_CLOCK_HZ / 1000000),
+           lcdStat.busyViolation,
+           lcdStat.timingViolation);
+  printf("%s\n    %s", isFirst ? "" : ",", line);
+
+  simCheck(0 == lcdStat.busyViolation + lcdStat.timingViolation, runId, "no violations");
+  if (!benchBaselineList.empty()) { benchBaselineCheck(line, runId); }
+}
+
+// the double conversion GeneralTimer used before the fixed point one, kept as the reference
+static uint64_t doubleTimeToTick(const uint64_t &time) {
+  return time / (UNIT_NANOSEC / (double)SIM_CLOCK_HZ);
+}
+
+static uint64_t doubleTickToTime(const uint64_t &tick) {
+  return tick * (UNIT_NANOSEC / (double)SIM_CLOCK_HZ);
+}
+
+/**
+ * @brief compare GeneralTimer nanosec conversions to the double ones, the speed is the one of the
+ * host so only the ratio means something
+ */
+static void tickConversionBench(void) {
+  static const uint64_t TOTAL_VALUE = 1000000;
+  static const uint64_t VALUE_STEP  = 4099;  // prime so every remainder gets hit
+
+  GeneralTimer generalTimer(UNIT_NANOSEC);
+  uint64_t     maxTickError = 0;
+  uint64_t     maxTimeError = 0;
+  for (uint64_t value = 0; value < TOTAL_VALUE * VALUE_STEP; value += VALUE_STEP) {
+    const uint64_t tick      = generalTimer.timeToTick(value);
+    const uint64_t time      = generalTimer.tickToTime(value);
+    const uint64_t tickRef   = doubleTimeToTick(value);
+    const uint64_t timeRef   = doubleTickToTime(value);
+    const uint64_t tickError = (tick > tickRef) ? (tick - tickRef) : (tickRef - tick);
+    const uint64_t timeError = (time > timeRef) ? (time - timeRef) : (timeRef - time);
+    if (tickError > maxTickError) { maxTickError = tickError; }
+    if (timeError > maxTimeError) { maxTimeError = timeError; }
+  }
+
+  volatile uint64_t sink      = 0;
+  const auto        fixedStart = std::chrono::steady_clock::now();
+  for (uint64_t value = 0; value < TOTAL_VALUE; ++value) { sink = generalTimer.timeToTick(value); }
+  const auto doubleStart = std::chrono::steady_clock::now();
+  for (uint64_t value = 0; value < TOTAL_VALUE; ++value) { sink = doubleTimeToTick(value); }
+  const auto doubleEnd = std::chrono::steady_clock::now();
+  (void)sink;
+
+  const double fixedTime =
+      std::chrono::duration<double, std::nano>(doubleStart - fixedStart).count() / TOTAL_VALUE;
+  const double doubleTime =
+      std::chrono::duration<double, std::nano>(doubleEnd - doubleStart).count() / TOTAL_VALUE;
+  printf("  \"tick_conversion\": {\"max_tick_error\": %" PRIu64 ", \"max_time_error_ns\": %" PRIu64
+         ", \"host_fixed_ns_per_call\": %.2f, \"host_double_ns_per_call\": %.2f}\n",
+         maxTickError,
+         maxTimeError,
+         fixedTime,
+         doubleTime);
+}
+
+int main(int argc, char *argv[]) {
+  if ((argc > 1) && !benchBaselineLoad(argv[1])) {
+    fprintf(stderr, "can't read the baseline %s\n", argv[1]);
+    return 1;
+  }
+
+  LcdConfig asyncConfig     = lcdConfigDefaultGet(PACING_BUSY_FLAG);
+  asyncConfig.isAsync       = true;
+  LcdConfig async8BitConfig = lcdConfig8BitGet(PACING_BUSY_FLAG);
+  async8BitConfig.isAsync   = true;
+  LcdConfig writeOnlyConfig = lcdConfigDefaultGet(PACING_FIXED_DELAY);
+  writeOnlyConfig.isWriteOnly = true;
+
+  // the sleeping mode sleeps through the startup waits and the clear display execution time
+  const BenchMode benchModeList[] = {
+      {"fixed_delay", lcdConfigDefaultGet(PACING_FIXED_DELAY), 0},
+      {"fixed_delay_sleep", lcdConfigDefaultGet(PACING_FIXED_DELAY), 100000},
+      {"busy_flag", lcdConfigDefaultGet(PACING_BUSY_FLAG), 0},
+      {"async", asyncConfig, 0},
+      {"async_dma", lcdConfigSinglePortGet(), 0},
+      {"busy_flag_8bit", lcdConfig8BitGet(PACING_BUSY_FLAG), 0},
+      {"async_8bit", async8BitConfig, 0},
+      {"write_only", writeOnlyConfig, 0}};
+
+  printf("{\n  \"benchmarks\": [");
+  bool isFirst = true;
+  for (const BenchMode &benchMode : benchModeList) {
+    for (const BenchCase &benchCase : benchCaseList) {
+      benchCaseRun(benchMode, benchCase, isFirst);
+      isFirst = false;
+    }
+  }
+  printf("\n  ],\n");
+
+  simReset();
+  tickConversionBench();
+  printf("}\n");
+  return (0 == simCheckFailGet()) ? 0 : 1;
+}
+
+#endif
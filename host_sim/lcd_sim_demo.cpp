@@ -0,0 +1,538 @@
+/**
+ * @brief runs the LcdDriver against the simulated controller and prints what the display shows as
+ * well as how long the bus was busy
+ *
+ * @file lcd_sim_demo.cpp
+ * @author Khoi Trinh
+ * @date 2018-09-23
+ */
+
+// only part of the host build
+#ifdef LCD_HOST_SIM
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include "general_timer/general_timer.hpp"
+#include "lcd_sim.hpp"
+#include "lcd_trace_vcd.hpp"
+#include "tiva_sim.hpp"
+
+// hardware
+#include "driverlib/sysctl.h"
+#include "inc/hw_memmap.h"
+
+using namespace lcddriver;
+using namespace tivasim;
+
+#ifdef LCD_TRACE
+/**
+ * @brief write the pin trace of the displayWrite of a demo to trace_<name>.vcd
+ */
+static void traceVcdSave(const char *name) {
+  LcdTraceCapture capture;
+  capture.tickHz  = SIM_CLOCK_HZ;
+  capture.dropped = lcdTraceDroppedGet();
+  LcdTraceEvent event;
+  while (lcdTraceRead(event)) { capture.eventList.push_back(event); }
+
+  char fileName[64];
+  snprintf(fileName, sizeof(fileName), "trace_%s.vcd", name);
+  FILE *file = fopen(fileName, "w");
+  if (!file) { return; }
+  lcdTraceVcdWrite(file, capture);
+  fclose(file);
+  printf("%zu pin changes written to %s, %" PRIu32 " dropped\n\n",
+         capture.eventList.size(),
+         fileName,
+         capture.dropped);
+}
+#endif
+
+static void demoRun(const LcdConfig &lcdConfig, const char *name) {
+  LcdSimFixture fixture(lcdConfig);
+  LcdDriver &   lcdDriver = fixture.driverGet();
+  lcdDriver.enable();
+
+  uint8_t charPattern0[] = {0b11111, 0b11000, 0b10100, 0b10111, 0b10101, 0b10101, 0b10101, 0b11111};
+  lcdDriver.newCustomCharAdd(charPattern0, 0);
+  lcdDriver.flush();
+
+  fixture.statReset();
+  lcdInstrumentReset();
+  lcdTraceReset();
+  const uint64_t startTime = simTimeGet();
+  lcdDriver.displayWrite("Temp: 23.5 C `0\nHumidity: 45 %");
+  const uint64_t returnTime = simTimeGet() - startTime;
+  // only the async modes return b4 the text is out
+  lcdDriver.flush();
+  const uint64_t    writeTime = simTimeGet() - startTime;
+  const Hd44780Stat lcdStat   = fixture.statGet();
+
+  printf("%s\n", name);
+  fixture.screenPrint();
+  printf("displayWrite: returned after %" PRIu64 " ns, done after %" PRIu64 " ns, %" PRIu64
+         " EN strobes, %" PRIu64 " interrupts, %" PRIu64 " busy violations, %" PRIu64
+         " timing violations\n\n",
+         returnTime,
+         writeTime,
+         lcdStat.enStrobe,
+         simStatGet().interruptCall,
+         lcdStat.busyViolation,
+         lcdStat.timingViolation);
+  // only prints when built with LCD_INSTRUMENT
+  lcdInstrumentDump();
+#ifdef LCD_TRACE
+  traceVcdSave(name);
+#endif
+}
+
+/**
+ * @brief a panel that the geometry demo writes to
+ */
+typedef struct {
+  const char *name;
+  LcdGeometry geometry;
+} DemoGeometry;
+
+static void geometryDemoRun(void) {
+  // a newline on the last row starts it over, text past the end of the last row is dropped
+  const DemoGeometry demoGeometryList[] = {{"8x1", LCD_GEOMETRY_8X1},
+                                           {"16x1", LCD_GEOMETRY_16X1},
+                                           {"16x2", LCD_GEOMETRY_16X2},
+                                           {"16x4", LCD_GEOMETRY_16X4},
+                                           {"20x2", LCD_GEOMETRY_20X2},
+                                           {"20x4", LCD_GEOMETRY_20X4},
+                                           {"40x2", LCD_GEOMETRY_40X2}};
+
+  printf("GEOMETRY\n");
+  for (const DemoGeometry &demoGeometry : demoGeometryList) {
+    LcdConfig lcdConfig = lcdConfigDefaultGet(PACING_BUSY_FLAG);
+    lcdConfig.geometry  = demoGeometry.geometry;
+    LcdSimFixture fixture(lcdConfig);
+    LcdDriver &   lcdDriver = fixture.driverGet();
+    lcdDriver.enable();
+
+    // the first row wraps on every panel, the newline then starts a new row
+    fixture.statReset();
+    const uint64_t startTime = simTimeGet();
+    lcdDriver.displayWrite("Rows wrap by themselves and\nnewline skips a row");
+    lcdDriver.displayAppend(", appended");
+    const uint64_t    writeTime = simTimeGet() - startTime;
+    const Hd44780Stat lcdStat   = fixture.statGet();
+
+    printf("%s: %" PRIu64 " characters and %" PRIu64 " instructions in %" PRIu64
+           " ns, %" PRIu64 " ns per character, %" PRIu64 " timing violations\n",
+           demoGeometry.name,
+           lcdStat.dataWrite,
+           lcdStat.instructionWrite,
+           writeTime,
+           writeTime / lcdStat.dataWrite,
+           lcdStat.timingViolation);
+    fixture.screenPrint();
+  }
+  printf("\n");
+}
+
+static void dualControllerDemoRun(const LcdPacingMode &pacingMode, const char *name) {
+  // a full screen on a single 40x2 controller, then on the 2 controllers of a 40x4 that take turns
+  LcdConfig lcdConfigList[] = {lcdConfigDefaultGet(pacingMode), lcdConfig40x4Get(pacingMode)};
+  lcdConfigList[0].geometry = LCD_GEOMETRY_40X2;
+
+  printf("%s\n", name);
+  for (const LcdConfig &lcdConfig : lcdConfigList) {
+    LcdSimFixture fixture(lcdConfig);
+    fixture.driverGet().enable();
+
+    // the text fills every row without a newline, the screen shows it split at the row ends
+    char     text[LCD_MAX_PRINT_STRING];
+    uint32_t textLen = 0;
+    for (uint32_t row = 0; row < lcdConfig.geometry.totalRow; ++row) {
+      for (uint32_t column = 0; column < lcdConfig.geometry.totalColumn; ++column) {
+        text[textLen++] = 'A' + (row * 7 + column) % 26;
+      }
+    }
+    text[textLen] = 0;
+
+    fixture.statReset();
+    const uint64_t startTime = simTimeGet();
+    fixture.driverGet().displayWrite(text);
+    const uint64_t    writeTime = simTimeGet() - startTime;
+    const Hd44780Stat lcdStat   = fixture.statGet();
+
+    printf("%" PRIu32 "x%" PRIu32 " on %" PRIu32 " EN: %" PRIu32 " characters in %" PRIu64
+           " ns, %" PRIu64 " ns per character, %" PRIu64 " busy violations, %" PRIu64
+           " timing violations\n",
+           (uint32_t)lcdConfig.geometry.totalColumn,
+           (uint32_t)lcdConfig.geometry.totalRow,
+           lcdConfig.totalController,
+           textLen,
+           writeTime,
+           writeTime / textLen,
+           lcdStat.busyViolation,
+           lcdStat.timingViolation);
+    fixture.screenPrint();
+  }
+  printf("\n");
+}
+
+/**
+ * @brief a step of the broadcast demo
+ */
+typedef struct {
+  const char *name;
+  uint32_t    displayMask;  //!< given to displaySelect()
+  const char *text;
+} DemoBroadcastStep;
+
+static uint64_t singleWriteTimeGet(const LcdPacingMode &pacingMode, const char *text) {
+  LcdSimFixture fixture(lcdConfigDefaultGet(pacingMode));
+  fixture.driverGet().enable();
+
+  const uint64_t startTime = simTimeGet();
+  fixture.driverGet().displayWrite(text);
+  return simTimeGet() - startTime;
+}
+
+static void broadcastDemoRun(const LcdPacingMode &pacingMode, const char *name) {
+  static const uint32_t TOTAL_DISPLAY = 3;
+  const LcdConfig       lcdConfig     = lcdConfigBroadcastGet(pacingMode, TOTAL_DISPLAY);
+
+  // the last display is given its own text and catches up with the others on the next write
+  const DemoBroadcastStep stepList[] = {{"all", 0x7, "Cabinet 1\nTemp: 23.5 C"},
+                                        {"display 2", 0x4, "Service door\nopen"},
+                                        {"all", 0x7, "Cabinet 1\nTemp: 23.6 C"}};
+
+  // the first write takes as long as on a single display
+  printf("%s\nsingle display: %" PRIu64 " ns\n",
+         name,
+         singleWriteTimeGet(pacingMode, stepList[0].text));
+
+  LcdSimFixture fixture(lcdConfig);
+  LcdDriver &   lcdDriver = fixture.driverGet();
+  lcdDriver.enable();
+
+  for (const DemoBroadcastStep &step : stepList) {
+    fixture.statReset();
+    const uint64_t startTime = simTimeGet();
+    lcdDriver.displaySelect(step.displayMask);
+    lcdDriver.displayWrite(step.text);
+    const uint64_t    writeTime = simTimeGet() - startTime;
+    const Hd44780Stat lcdStat   = fixture.statGet();
+
+    printf("%s: %" PRIu64 " ns, characters per display", step.name, writeTime);
+    for (uint32_t display = 0; display < TOTAL_DISPLAY; ++display) {
+      printf(" %" PRIu64, fixture.lcdSimGet(display).statGet().dataWrite);
+    }
+    printf(", %" PRIu64 " violations\n", lcdStat.busyViolation + lcdStat.timingViolation);
+
+    // the displays in the mask show the text, the others keep theirs
+    for (uint32_t display = 0; display < TOTAL_DISPLAY; ++display) {
+      lcdScreenPrint(fixture.lcdSimGet(display), lcdConfig.geometry);
+    }
+  }
+  printf("\n");
+}
+
+/**
+ * @brief a timeout armed on the GeneralTimer wheel and when it should run
+ */
+typedef struct {
+  TimerWheelEntry entry;
+  uint64_t        dueTime;  //!< virtual nanosec
+  uint64_t        period;   //!< nanosec, 0 for one shot
+} DemoTimeout;
+
+static uint64_t demoTimeoutRun      = 0;
+static uint64_t demoTimeoutEarly    = 0;
+static uint64_t demoTimeoutLateness = 0;  //!< the most that a callback ran after its due time
+
+static void demoTimeoutCallback(void *context) {
+  DemoTimeout &  timeout = *(DemoTimeout *)context;
+  const uint64_t runTime = simTimeGet();
+  ++demoTimeoutRun;
+  if (runTime < timeout.dueTime) {
+    ++demoTimeoutEarly;
+  } else if (runTime - timeout.dueTime > demoTimeoutLateness) {
+    demoTimeoutLateness = runTime - timeout.dueTime;
+  }
+  timeout.dueTime += timeout.period;
+}
+
+static void timerWheelDemoRun(void) {
+  static const uint32_t TOTAL_ONE_SHOT = 256;
+  static const uint32_t TOTAL_PERIODIC = 16;
+  static DemoTimeout    timeoutList[TOTAL_ONE_SHOT + TOTAL_PERIODIC];
+
+  simReset();
+  simListenerClear();
+  simTimerIsrSet(WTIMER0_BASE, GeneralTimerIntHandler);
+  GeneralTimer generalTimer(UNIT_NANOSEC);
+
+  // one shots spread over 50 ms with a fixed pseudo random sequence, periodic ones every 1-16 ms
+  uint32_t randomValue = 1;
+  for (uint32_t index = 0; index < TOTAL_ONE_SHOT + TOTAL_PERIODIC; ++index) {
+    DemoTimeout &timeout = timeoutList[index];
+    randomValue          = randomValue * 1103515245 + 12345;
+    const uint64_t delay = (index < TOTAL_ONE_SHOT)
+                               ? ((uint64_t)(randomValue >> 8) * 50000000) >> 24
+                               : (index - TOTAL_ONE_SHOT + 1) * 1000000;
+    timeout.period  = (index < TOTAL_ONE_SHOT) ? 0 : delay;
+    timeout.dueTime = simTimeGet() + delay;
+    generalTimer.timeoutAdd(timeout.entry, delay, timeout.period, demoTimeoutCallback, &timeout);
+  }
+
+  // the application cancels some of them along the way
+  simStatReset();
+  simTimeAdvance(20000000);
+  uint32_t totalCancel = 0;
+  for (uint32_t index = 0; index < TOTAL_ONE_SHOT; index += 4) {
+    totalCancel += TimerWheel::isArmed(timeoutList[index].entry) ? 1 : 0;
+    GeneralTimer::timeoutCancel(timeoutList[index].entry);
+  }
+  simTimeAdvance(80000000);
+  for (uint32_t index = TOTAL_ONE_SHOT; index < TOTAL_ONE_SHOT + TOTAL_PERIODIC; ++index) {
+    GeneralTimer::timeoutCancel(timeoutList[index].entry);
+  }
+
+  printf("TIMER_WHEEL\n");
+  printf("%" PRIu32 " one shot and %" PRIu32 " periodic timeouts over 100 ms, %" PRIu32
+         " cancelled: %" PRIu64 " callbacks, %" PRIu64 " interrupts, %" PRIu64
+         " ns max lateness, %" PRIu64 " early\n\n",
+         TOTAL_ONE_SHOT,
+         TOTAL_PERIODIC,
+         totalCancel,
+         demoTimeoutRun,
+         simStatGet().interruptCall,
+         demoTimeoutLateness,
+         demoTimeoutEarly);
+}
+
+static uint64_t demoHeartbeatRun = 0;
+
+static void demoHeartbeatCallback(void *context) { ++demoHeartbeatRun; }
+
+static void sleepWaitDemoRun(void) {
+  LcdSimFixture fixture(lcdConfigDefaultGet(PACING_FIXED_DELAY));
+
+  // waits from 100 us sleep, a 1 ms heartbeat stands for the application's own interrupts
+  GeneralTimer generalTimer(UNIT_NANOSEC);
+  generalTimer.sleepWaitSet(100000);
+  TimerWheelEntry heartbeat = TimerWheelEntry();
+  demoHeartbeatRun          = 0;
+  generalTimer.timeoutAdd(heartbeat, 1000000, 1000000, demoHeartbeatCallback, nullptr);
+
+  const uint64_t startTime = simTimeGet();
+  fixture.statReset();
+  fixture.driverGet().enable();
+  const uint64_t enableTime = simTimeGet() - startTime;
+  GeneralTimer::timeoutCancel(heartbeat);
+  generalTimer.sleepWaitSet(0);
+
+  const GeneralTimerStat &timerStat = GeneralTimer::statGet();
+  printf("SLEEP_WAIT\n");
+  printf("enable: %" PRIu64 " ns, %" PRIu64 " ns asleep in %" PRIu64 " waits, %" PRIu64
+         " heartbeats ran, wake up %" PRIu64 " ns late at most, %" PRIu64
+         " timing violations\n\n",
+         enableTime,
+         simStatGet().sleepTime,
+         timerStat.sleepCall,
+         demoHeartbeatRun,
+         timerStat.wakeLateTickMax * 1000 / (SIM_CLOCK_HZ / 1000000),
+         fixture.statGet().timingViolation);
+}
+
+static void enableAsyncDemoRun(void) {
+  LcdSimFixture  fixture(lcdConfigDefaultGet(PACING_BUSY_FLAG));
+  LcdDriver &    lcdDriver = fixture.driverGet();
+  const uint64_t startTime = simTimeGet();
+  lcdDriver.enableAsync();
+
+  // 1 ms of work per loop stands for the rest of the system starting up
+  uint32_t workDone = 0;
+  uint64_t stepTime = 0;
+  for (;;) {
+    const uint64_t stepStartTime = simTimeGet();
+    const bool     isEnabled     = lcdDriver.enableStep();
+    stepTime += simTimeGet() - stepStartTime;
+    if (isEnabled) { break; }
+    SysCtlDelay(SIM_CLOCK_HZ / 3000);
+    ++workDone;
+  }
+  const uint64_t readyTime = simTimeGet() - startTime;
+
+  lcdDriver.displayWrite("Booted");
+  const bool isShown = "Booted" == fixture.screenGet();
+  printf("ENABLE_ASYNC\n");
+  printf("ready after %" PRIu64 " ns, %" PRIu64 " ns spent in enableStep, %" PRIu32
+         " ms of other work done meanwhile, %s, %" PRIu64 " timing violations\n\n",
+         readyTime,
+         stepTime,
+         workDone,
+         isShown ? "text shown" : "text wrong",
+         fixture.statGet().timingViolation);
+}
+
+/**
+ * @brief a controller that the calibration is run against
+ */
+typedef struct {
+  const char *name;
+  SimTiming   simTiming;
+} DemoController;
+
+static void calibrationDemoRun(void) {
+  // strict controllers latch garbage when the timing is too short, the slow one can't even take
+  // the datasheet timing that enable() uses, a controller faster than the datasheet one isn't
+  // listed since the gpio calls of a strobe alone outlast both and they'd both stay at 100 %
+  const DemoController demoControllerList[] = {{"datasheet", {230, 500, 40, 80, true}},
+                                               {"marginal", {690, 1500, 120, 240, true}},
+                                               {"slow", {900, 2000, 200, 350, true}}};
+  const uint32_t    totalDemoController = sizeof(demoControllerList) / sizeof(DemoController);
+  const std::string text                = "Temp: 23.5 C\nHumidity: 45 %";
+
+  printf("TIMING_CALIBRATION\n");
+  for (uint32_t index = 0; index < totalDemoController; ++index) {
+    const DemoController &demoController = demoControllerList[index];
+    LcdSimFixture         fixture(lcdConfigDefaultGet(PACING_BUSY_FLAG));
+    LcdDriver &           lcdDriver = fixture.driverGet();
+    fixture.lcdSimGet(0).timingSet(demoController.simTiming);
+
+    lcdDriver.enable();
+    const uint64_t enableViolation = fixture.statGet().timingViolation;
+    uint64_t       startTime       = simTimeGet();
+    const bool     isCalibrated    = lcdDriver.timingCalibrate();
+    const uint64_t calibrateTime   = simTimeGet() - startTime;
+
+    fixture.statReset();
+    startTime = simTimeGet();
+    lcdDriver.displayWrite(text.c_str());
+    const uint64_t writeTime = simTimeGet() - startTime;
+    const bool     isShown   = text == fixture.screenGet();
+
+    printf("%s controller: %" PRIu64 " timing violations in enable, %s to %" PRIu32
+           " %% of the datasheet timing in %" PRIu64 " ns, displayWrite %" PRIu64
+           " ns, %s, %" PRIu64 " timing violations\n",
+           demoController.name,
+           enableViolation,
+           isCalibrated ? "calibrated" : "not calibrated",
+           lcdDriver.timingPercentGet(),
+           calibrateTime,
+           writeTime,
+           isShown ? "text shown" : "text wrong",
+           fixture.statGet().timingViolation);
+  }
+  printf("\n");
+}
+
+/**
+ * @brief one boot of the TivaC, enable() and the restore of the custom characters it does
+ */
+static void recordBootRun(Hd44780Sim &lcdSim, const uint32_t &resetCause, const char *bootName) {
+  const LcdConfig lcdConfig = lcdConfigDefaultGet(PACING_BUSY_FLAG);
+  simResetCauseSet(resetCause);
+  lcdSim.statReset();
+
+  auto       lcdDriver = LcdDriver(lcdConfig);
+  const bool isLoaded  = lcdDriver.recordLoad();
+  lcdDriver.init();
+  const uint64_t startTime = simTimeGet();
+  lcdDriver.enable();
+  const uint64_t enableTime = simTimeGet() - startTime;
+  const uint64_t charUpload = lcdSim.statGet().dataWrite;
+
+  if (!isLoaded) {
+    lcdDriver.timingCalibrate();
+    for (uint32_t slot = 0; slot < MAX_TOTAL_CUSTOM_PATTERN; ++slot) {
+      uint8_t charPattern[CUSTOM_CHAR_PATTERN_LEN];
+      for (uint32_t row = 0; row < CUSTOM_CHAR_PATTERN_LEN; ++row) {
+        charPattern[row] = (slot * 5 + row * 3) & 0x1f;
+      }
+      lcdDriver.newCustomCharAdd(charPattern, slot);
+    }
+  }
+  const bool isSaved = lcdDriver.recordSave();
+
+  bool isCharKept = true;
+  for (uint32_t slot = 0; slot < MAX_TOTAL_CUSTOM_PATTERN; ++slot) {
+    for (uint32_t row = 0; row < CUSTOM_CHAR_PATTERN_LEN; ++row) {
+      const uint8_t addr = slot * CUSTOM_CHAR_PATTERN_LEN + row;
+      isCharKept         = isCharKept && (((slot * 5 + row * 3) & 0x1f) == lcdSim.cgramGet(addr));
+    }
+  }
+
+  printf("%s: record %s, enable %" PRIu64 " ns, %" PRIu64 " custom character bytes uploaded, "
+         "timing %" PRIu32 " %%, %s, record %s\n",
+         bootName,
+         isLoaded ? "loaded" : "not found",
+         enableTime,
+         charUpload,
+         lcdDriver.timingPercentGet(),
+         isCharKept ? "custom characters right" : "custom characters wrong",
+         isSaved ? "saved" : "not saved");
+}
+
+static void recordDemoRun(void) {
+  printf("EEPROM_RECORD\n");
+  simReset();
+  simListenerClear();
+  const LcdConfig lcdConfig = lcdConfigDefaultGet(PACING_BUSY_FLAG);
+  Hd44780Sim      lcdSim(lcdWiringGet(lcdConfig));
+  simListenerAdd(&lcdSim);
+
+  // the EEPROM and the lcd both outlive a reset of the TivaC
+  recordBootRun(lcdSim, SYSCTL_CAUSE_POR, "first boot");
+  recordBootRun(lcdSim, SYSCTL_CAUSE_EXT, "reset");
+  lcdSim.powerOn();
+  recordBootRun(lcdSim, SYSCTL_CAUSE_POR, "power cycle");
+
+  // a record only passes with its own magic, version and CRC
+  LcdRecord        record;
+  LcdRecordContent content;
+  memcpy(&record, simEepromGet() + LCD_EEPROM_ADDR, sizeof(record));
+  const bool isValid = lcdRecordDecode(record, content);
+  lcdRecordEncode(content, record);
+  LcdRecord changedRecord = record;
+  changedRecord.content.customCharList[3][2] ^= 0x01;
+  const bool isCorruptValid = lcdRecordDecode(changedRecord, content);
+  changedRecord = record;
+  ++changedRecord.version;
+  const bool isOldValid = lcdRecordDecode(changedRecord, content);
+  printf("stored record %s, flipped bit %s, other version %s\n\n",
+         isValid ? "valid" : "invalid",
+         isCorruptValid ? "accepted" : "rejected",
+         isOldValid ? "accepted" : "rejected");
+  simResetCauseSet(SYSCTL_CAUSE_POR);
+}
+
+int main(void) {
+  demoRun(lcdConfigDefaultGet(PACING_FIXED_DELAY), "PACING_FIXED_DELAY");
+  demoRun(lcdConfigDefaultGet(PACING_BUSY_FLAG), "PACING_BUSY_FLAG");
+  demoRun(lcdConfig8BitGet(PACING_BUSY_FLAG), "PACING_BUSY_FLAG_8BIT");
+  // the driver falls back to PACING_FIXED_DELAY on its own
+  LcdConfig lcdConfig   = lcdConfigDefaultGet(PACING_BUSY_FLAG);
+  lcdConfig.isWriteOnly = true;
+  demoRun(lcdConfig, "WRITE_ONLY");
+  geometryDemoRun();
+  dualControllerDemoRun(PACING_FIXED_DELAY, "DUAL_CONTROLLER_FIXED_DELAY");
+  dualControllerDemoRun(PACING_BUSY_FLAG, "DUAL_CONTROLLER_BUSY_FLAG");
+  broadcastDemoRun(PACING_FIXED_DELAY, "BROADCAST_FIXED_DELAY");
+  broadcastDemoRun(PACING_BUSY_FLAG, "BROADCAST_BUSY_FLAG");
+  lcdConfig         = lcdConfigDefaultGet(PACING_BUSY_FLAG);
+  lcdConfig.isAsync = true;
+  demoRun(lcdConfig, "ASYNC");
+  lcdConfig         = lcdConfig8BitGet(PACING_BUSY_FLAG);
+  lcdConfig.isAsync = true;
+  demoRun(lcdConfig, "ASYNC_8BIT");
+  demoRun(lcdConfigSinglePortGet(), "ASYNC_DMA");
+  timerWheelDemoRun();
+  sleepWaitDemoRun();
+  enableAsyncDemoRun();
+  calibrationDemoRun();
+  recordDemoRun();
+  return 0;
+}
+
+#endif
@@ -0,0 +1,945 @@
+/**
+ * @brief checks of single LcdDriver features against the simulated controller, each test prints
+ * whether it passed and the failed checks go to stderr
+ *
+ * @file lcd_sim_test.cpp
+ * @author Khoi Trinh
+ * @date 2018-09-23
+ */
+
+// only part of the host build
+#ifdef LCD_HOST_SIM
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include "general_timer/general_timer.hpp"
+#include "lcd_sim.hpp"
+#include "lcd_static_driver.hpp"
+#include "lcd_waveform.hpp"
+#include "tiva_sim.hpp"
+#include "tiva_utils/bit_manipulation.h"
+
+// hardware
+#include "driverlib/sysctl.h"
+#include "inc/hw_memmap.h"
+
+using namespace lcddriver;
+using namespace tivasim;
+
+/**
+ * @brief a test, run() passes the name to simCheck() as the context
+ */
+typedef struct {
+  const char *name;
+  void (*run)(const char *name);
+} SimTest;
+
+/**
+ * @brief a controller that never clears its busy flag, it pulls D7 high whenever the bus is read
+ */
+class StuckBusySim : public PinListener {
+ private:
+  SimPin _busyPin;
+
+ public:
+  StuckBusySim(const SimPin &busyPin) : _busyPin(busyPin) {}
+
+  void    pinChanged(const uint64_t &timeNanoSec) override {}
+  uint8_t pinDrive(const uint32_t &portBase) override {
+    return (portBase == _busyPin.portBase) ? _busyPin.pinMask : 0;
+  }
+};
+
+static void busyFlagTest(const char *name) {
+  LcdSimFixture fixture(lcdConfigDefaultGet(PACING_BUSY_FLAG));
+  fixture.driverGet().enable();
+
+  fixture.statReset();
+  fixture.driverGet().displayWrite("Temp: 23.5 C\nHumidity: 45 %");
+  const Hd44780Stat lcdStat = fixture.statGet();
+
+  simCheck("Temp: 23.5 C\nHumidity: 45 %" == fixture.screenGet(), name, "text shown");
+  // the flag is read b4 every byte instead of waiting out the execution time
+  simCheck(lcdStat.statusRead >= lcdStat.instructionWrite + lcdStat.dataWrite,
+           name,
+           "busy flag read b4 every byte");
+  simCheck(0 == lcdStat.busyViolation + lcdStat.timingViolation, name, "no violations");
+}
+
+static void busyFlagTimeoutTest(const char *name) {
+  const LcdConfig lcdConfig = lcdConfigDefaultGet(PACING_BUSY_FLAG);
+  LcdSimFixture   fixture(lcdConfig);
+  fixture.driverGet().enable();
+
+  StuckBusySim stuckBusySim(lcdWiringGet(lcdConfig).dataPinList[3]);
+  simListenerAdd(&stuckBusySim);
+  fixture.statReset();
+  const uint64_t startTime = simTimeGet();
+  fixture.driverGet().displayAppend("ab");
+  const uint64_t appendTime = simTimeGet() - startTime;
+  simListenerClear();
+
+  // the driver gives up on the flag once per byte instead of hanging
+  const Hd44780Stat lcdStat   = fixture.statGet();
+  const uint64_t    totalByte = lcdStat.instructionWrite + lcdStat.dataWrite;
+  simCheck("ab" == fixture.screenGet(), name, "text shown");
+  simCheck((appendTime > totalByte * LCD_BUSY_POLL_TIMEOUT_NANOSEC) &&
+               (appendTime < (totalByte + 1) * LCD_BUSY_POLL_TIMEOUT_NANOSEC),
+           name,
+           "poll timed out once per byte");
+}
+
+/**
+ * @brief check that every nibble goes out with one store per port holding data pins
+ * @param storePerNibble how many ports the data pins of lcdConfig are spread over
+ */
+static void dataStoreCheck(const LcdConfig &lcdConfig,
+                           const uint64_t & storePerNibble,
+                           const char *     name) {
+  LcdSimFixture fixture(lcdConfig);
+  fixture.driverGet().enable();
+
+  fixture.statReset();
+  fixture.driverGet().displayWrite("Temp: 23.5 C\nHumidity: 45 %");
+  const Hd44780Stat lcdStat       = fixture.statGet();
+  const uint64_t    nibblePerByte = lcdConfig.is8BitBus ? 1 : 2;
+  const uint64_t    totalNibble   = (lcdStat.instructionWrite + lcdStat.dataWrite) * nibblePerByte;
+
+  simCheck("Temp: 23.5 C\nHumidity: 45 %" == fixture.screenGet(), name, "text shown");
+  simCheck(lcdDataStoreGet(lcdConfig) == totalNibble * storePerNibble,
+           name,
+           "one store per data port for each nibble");
+}
+
+static void dataStoreTest(const char *name) {
+  // D4-D6 on port E and D7 on port D, the pins of a port share a store
+  dataStoreCheck(lcdConfigDefaultGet(PACING_FIXED_DELAY), 2, name);
+  // D0-D3 on port C and D4-D7 on port B
+  dataStoreCheck(lcdConfig8BitGet(PACING_FIXED_DELAY), 2, name);
+}
+
+static void textRunTest(const char *name) {
+  // an address instruction and the 2 runs around the newline, the escape and the tab don't split
+  // a run
+  const char *    text             = "ab `2c\td\nxyz";
+  const LcdConfig fixedDelayConfig = lcdConfigDefaultGet(PACING_FIXED_DELAY);
+  const LcdConfig busyFlagConfig   = lcdConfigDefaultGet(PACING_BUSY_FLAG);
+
+  LcdSimFixture fixedDelayFixture(fixedDelayConfig);
+  fixedDelayFixture.driverGet().enable();
+  fixedDelayFixture.statReset();
+  fixedDelayFixture.driverGet().displayAppend(text);
+  simCheck("ab 2cd\nxyz" == fixedDelayFixture.screenGet(), name, "text shown");
+  simCheck(3 == lcdTransactionGet(fixedDelayConfig), name, "one transaction per run");
+
+  // every byte is written after a busy flag read of its own
+  LcdSimFixture busyFlagFixture(busyFlagConfig);
+  busyFlagFixture.driverGet().enable();
+  busyFlagFixture.statReset();
+  busyFlagFixture.driverGet().displayAppend(text);
+  const Hd44780Stat lcdStat = busyFlagFixture.statGet();
+  simCheck("ab 2cd\nxyz" == busyFlagFixture.screenGet(), name, "text shown with busy flag");
+  simCheck(lcdTransactionGet(busyFlagConfig) ==
+               lcdStat.statusRead + lcdStat.instructionWrite + lcdStat.dataWrite,
+           name,
+           "one transaction per byte and per busy flag read with busy flag");
+}
+
+static void busDirectionTest(const char *name) {
+  const char *text = "Temp: 23.5 C\nHumidity: 45 %";
+
+  // writes never turn the bus around
+  LcdSimFixture fixedDelayFixture(lcdConfigDefaultGet(PACING_FIXED_DELAY));
+  fixedDelayFixture.driverGet().enable();
+  fixedDelayFixture.statReset();
+  fixedDelayFixture.driverGet().displayAppend(text);
+  simCheck(0 == simStatGet().gpioDirCall, name, "no direction change while writing");
+
+  // the bus turns to input for the flag and back to output for the byte, once per byte however
+  // many times the flag is read, with one GPIODirModeSet per data port(E and D)
+  const uint64_t totalDataPort = 2;
+  LcdSimFixture  busyFlagFixture(lcdConfigDefaultGet(PACING_BUSY_FLAG));
+  busyFlagFixture.driverGet().enable();
+  busyFlagFixture.statReset();
+  busyFlagFixture.driverGet().displayAppend(text);
+  const Hd44780Stat lcdStat = busyFlagFixture.statGet();
+  simCheck(lcdStat.statusRead > lcdStat.instructionWrite + lcdStat.dataWrite,
+           name,
+           "flag read more than once per byte");
+  simCheck(simStatGet().gpioDirCall ==
+               2 * totalDataPort * (lcdStat.instructionWrite + lcdStat.dataWrite),
+           name,
+           "2 direction changes per byte with busy flag");
+}
+
+static void idleCallback(void *context) { ++*(uint32_t *)context; }
+
+static void asyncQueueTest(const char *name) {
+  LcdConfig lcdConfig = lcdConfigDefaultGet(PACING_BUSY_FLAG);
+  lcdConfig.isAsync   = true;
+  LcdSimFixture fixture(lcdConfig);
+  LcdDriver &   lcdDriver = fixture.driverGet();
+  lcdDriver.enable();
+  uint32_t totalIdleCall = 0;
+  lcdDriver.idleCallbackSet(idleCallback, &totalIdleCall);
+
+  // the write only queues the bytes, the timer interrupt sends them
+  fixture.statReset();
+  const uint64_t startTime = simTimeGet();
+  lcdDriver.displayWrite("Temp: 23.5 C\nHumidity: 45 %");
+  const uint64_t returnTime = simTimeGet() - startTime;
+  const bool     isIdle     = lcdDriver.isIdle();
+  lcdDriver.flush();
+  const uint64_t busTime = simTimeGet() - startTime;
+  simCheck(!isIdle && lcdDriver.isIdle(), name, "busy until flushed");
+  simCheck(returnTime * 10 < busTime, name, "returned b4 a tenth of the bus time");
+  simCheck(simStatGet().interruptCall > 0, name, "sent from the interrupt");
+  simCheck(1 == totalIdleCall, name, "idle callback once the queue drained");
+  simCheck("Temp: 23.5 C\nHumidity: 45 %" == fixture.screenGet(), name, "text shown");
+
+  // more than LCD_TX_QUEUE_LEN bytes wait for room instead of being dropped
+  uint8_t charPattern[CUSTOM_CHAR_PATTERN_LEN] = {0x1f, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x1f};
+  for (uint32_t slot = 0; slot < MAX_TOTAL_CUSTOM_PATTERN; ++slot) {
+    lcdDriver.newCustomCharAdd(charPattern, slot);
+  }
+  lcdDriver.flush();
+  bool isCharKept = true;
+  for (uint32_t addr = 0; addr < MAX_TOTAL_CUSTOM_PATTERN * CUSTOM_CHAR_PATTERN_LEN; ++addr) {
+    const uint8_t cgramData = fixture.lcdSimGet(0).cgramGet(addr);
+    isCharKept = isCharKept && (cgramData == charPattern[addr % CUSTOM_CHAR_PATTERN_LEN]);
+  }
+  simCheck(isCharKept, name, "custom characters past the queue length kept");
+  simCheck(0 == fixture.statGet().busyViolation + fixture.statGet().timingViolation,
+           name,
+           "no violations");
+}
+
+/**
+ * @brief the pins of lcdConfigDefaultGet() as a compile time pin map
+ */
+typedef LcdPinMap<LcdPin<GPIO_PORTB_BASE, GPIO_PIN_7>,  // RS
+                  LcdPin<GPIO_PORTF_BASE, GPIO_PIN_4>,  // RW
+                  LcdPin<GPIO_PORTE_BASE, GPIO_PIN_3>,  // EN
+                  LcdPin<GPIO_PORTE_BASE, GPIO_PIN_2>,  // D4
+                  LcdPin<GPIO_PORTE_BASE, GPIO_PIN_1>,  // D5
+                  LcdPin<GPIO_PORTE_BASE, GPIO_PIN_0>,  // D6
+                  LcdPin<GPIO_PORTD_BASE, GPIO_PIN_6>,  // D7
+                  LcdPin<GPIO_PORTB_BASE, GPIO_PIN_6>>  // backlight
+    SimPinMap;
+
+static void staticDriverTest(const char *name) {
+  // no LcdDriver here so the model is set up without the fixture
+  const LcdConfig lcdConfig = lcdConfigDefaultGet(PACING_FIXED_DELAY);
+  simReset();
+  simListenerClear();
+  Hd44780Sim lcdSim(lcdWiringGet(lcdConfig));
+  simListenerAdd(&lcdSim);
+
+  LcdStaticDriver<SimPinMap> lcdDriver;
+  lcdDriver.init();
+  lcdDriver.enable();
+  lcdSim.statReset();
+  simStatReset();
+  lcdDriver.displayWrite("Temp: 23.5 C\nHumidity: 45 %");
+  const Hd44780Stat lcdStat     = lcdSim.statGet();
+  const uint64_t    totalNibble = (lcdStat.instructionWrite + lcdStat.dataWrite) * 2;
+
+  simCheck("Temp: 23.5 C\nHumidity: 45 %" == lcdScreenGet(lcdSim, LCD_GEOMETRY_16X2),
+           name,
+           "text shown");
+  simCheck(0 == lcdStat.busyViolation + lcdStat.timingViolation, name, "no violations");
+  // D4-D6 on port E and D7 on port D, the pins of a port share a store
+  simCheck(lcdDataStoreGet(lcdConfig) == totalNibble * 2,
+           name,
+           "one store per data port for each nibble");
+  simCheck(0 == simStatGet().gpioReadCall, name, "nothing read back");
+}
+
+/**
+ * @brief EN and RS on bits 0 and 1, the nibble on the top 4 bits of the port
+ */
+static const uint8_t WAVEFORM_EN_PIN = 0x01;
+static const uint8_t WAVEFORM_RS_PIN = 0x02;
+
+static void waveformTest(const char *name) {
+  LcdWaveformPinMap pinMap;
+  pinMap.regSelectPin = WAVEFORM_RS_PIN;
+  pinMap.readWritePin = 0;
+  pinMap.enablePin    = WAVEFORM_EN_PIN;
+  for (uint8_t nibble = 0; nibble < 16; ++nibble) { pinMap.nibbleOutput[nibble] = nibble << 4; }
+  static uint8_t waveformBuffer[2 * LCD_DMA_WAVEFORM_LEN];
+  LcdWaveform    waveform;
+  waveform.configure(pinMap, LCD_DMA_SLOT_NANOSEC, waveformBuffer, sizeof(waveformBuffer));
+
+  // the timing that LcdDriver gives the engine when streaming
+  LcdTxTiming txTiming;
+  txTiming.addrSetupTime = LCD_ADDR_SETUP_TIME_NANOSEC + TIVA_MAX_RISE_TIME;
+  txTiming.pulseWidth    = LCD_PULSE_WIDTH_NANOSEC + TIVA_MAX_RISE_TIME;
+  txTiming.enableLowTime =
+      LCD_MIN_CYCLE_TIME_NANOSEC - LCD_PULSE_WIDTH_NANOSEC + TIVA_MAX_FALSE_TIME;
+  txTiming.execTime     = LCD_EXEC_TIME_NANOSEC;
+  txTiming.ramExecTime  = LCD_EXEC_TIME_NANOSEC + LCD_ADDR_UPDATE_TIME_NANOSEC;
+  txTiming.longExecTime = LCD_CLEAR_EXEC_TIME_NANOSEC;
+  LcdTxEngine txEngine(&waveform);
+  txEngine.configure(txTiming, 2);
+
+  const LcdTxItem itemList[] = {
+      {0x28, false}, {'A', true}, {'B', true}, {LCD_CLEAR_COMMAND, false}, {'C', true}};
+  const uint32_t totalItem = sizeof(itemList) / sizeof(itemList[0]);
+  for (const LcdTxItem &item : itemList) { txEngine.itemPush(item.data, item.isDataReg); }
+  txEngine.start();
+  const uint32_t waveformLen = waveform.record(txEngine);
+  simCheck(0 == waveform.record(txEngine), name, "whole queue recorded at once");
+
+  // walk the slots, the port starts out all low
+  uint8_t  prevOutput  = 0;
+  uint32_t changeSlot  = 0;  // last slot where RS or the data changed
+  uint32_t riseSlot    = 0;
+  uint32_t fallSlot    = 0;
+  uint32_t totalStrobe = 0;
+  uint8_t  latchByte   = 0;
+  bool     isTimingMet = true;
+  bool     isHeld      = true;
+  bool     isLatchOk   = true;
+  for (uint32_t slot = 0; slot < waveformLen; ++slot) {
+    const uint8_t portOutput = waveformBuffer[slot];
+    const uint8_t busChange  = (portOutput ^ prevOutput) & ~WAVEFORM_EN_PIN;
+    const uint8_t enChange   = (portOutput ^ prevOutput) & WAVEFORM_EN_PIN;
+    const bool    isRise     = enChange && (portOutput & WAVEFORM_EN_PIN);
+    const bool    isFall     = enChange && !(portOutput & WAVEFORM_EN_PIN);
+    if (busChange) { changeSlot = slot; }
+
+    if (isRise) {
+      isTimingMet = isTimingMet &&
+                    ((slot - changeSlot) * LCD_DMA_SLOT_NANOSEC >= LCD_ADDR_SETUP_TIME_NANOSEC);
+      if (totalStrobe & 1) {
+        isTimingMet = isTimingMet &&
+                      ((slot - riseSlot) * LCD_DMA_SLOT_NANOSEC >= LCD_MIN_CYCLE_TIME_NANOSEC);
+      } else if (totalStrobe > 0) {
+        // the byte b4 has to be executed
+        const LcdTxItem &prevItem = itemList[totalStrobe / 2 - 1];
+        const uint32_t   execTime =
+            prevItem.isDataReg ? txTiming.ramExecTime
+                               : (LCD_CLEAR_COMMAND == prevItem.data) ? txTiming.longExecTime
+                                                                      : txTiming.execTime;
+        isTimingMet = isTimingMet && ((slot - fallSlot) * LCD_DMA_SLOT_NANOSEC >= execTime);
+      }
+      riseSlot = slot;
+    }
+
+    if (isFall) {
+      // the slot with the EN fall still has the bus of the slot b4
+      isHeld = isHeld && (0 == busChange);
+      isTimingMet =
+          isTimingMet && ((slot - riseSlot) * LCD_DMA_SLOT_NANOSEC >= LCD_PULSE_WIDTH_NANOSEC);
+      latchByte = (latchByte << 4) | (prevOutput >> 4);
+      if ((totalStrobe & 1) && (totalStrobe / 2 < totalItem)) {
+        const LcdTxItem &item = itemList[totalStrobe / 2];
+        isLatchOk             = isLatchOk && (latchByte == item.data) &&
+                    (item.isDataReg == (0 != (prevOutput & WAVEFORM_RS_PIN)));
+      }
+      fallSlot = slot;
+      ++totalStrobe;
+    }
+    prevOutput = portOutput;
+  }
+
+  simCheck(2 * totalItem == totalStrobe, name, "two strobes per byte");
+  simCheck(isLatchOk, name, "bytes latched in order");
+  simCheck(isTimingMet, name, "setup, pulse width, cycle and execution times met");
+  simCheck(isHeld, name, "bus held for the slot of each EN fall");
+  simCheck((waveformLen - fallSlot) * LCD_DMA_SLOT_NANOSEC >= txTiming.ramExecTime,
+           name,
+           "last byte executed b4 the end");
+}
+
+/**
+ * @brief a TimerWheel entry and what its runs saw
+ */
+typedef struct {
+  TimerWheelEntry  entry;
+  TimerWheel *     wheel;
+  TimerWheelEntry *cancelEntry;  //!< cancelled by the callback, nullptr for none
+  uint64_t         runTick;      //!< tick of the last run
+  uint32_t         totalRun;
+} WheelTimeout;
+
+static void wheelTimeoutCallback(void *context) {
+  WheelTimeout &timeout = *(WheelTimeout *)context;
+  timeout.runTick       = timeout.wheel->currTickGet();
+  ++timeout.totalRun;
+  if (timeout.cancelEntry) { timeout.wheel->cancel(*timeout.cancelEntry); }
+}
+
+static void wheelTimeoutAdd(TimerWheel &     wheel,
+                            WheelTimeout &   timeout,
+                            const uint64_t & expireTick,
+                            const uint64_t & periodTick,
+                            TimerWheelEntry *cancelEntry) {
+  timeout.wheel       = &wheel;
+  timeout.cancelEntry = cancelEntry;
+  wheel.add(timeout.entry, expireTick, periodTick, wheelTimeoutCallback, &timeout);
+}
+
+static void timerWheelTest(const char *name) {
+  // furthest the top level reaches, timeouts past it are parked there
+  static const uint64_t MAX_DELTA = (1ull << (TIMER_WHEEL_SLOT_BIT * TIMER_WHEEL_LEVEL)) - 1;
+
+  // both sides of every level edge, the top of the wheel and past it, only advanced to the ticks
+  // that nextTickGet() gives so each one has to run on its own tick
+  const uint64_t expireList[] = {1,    63,     64,     65,        4095,          4096,
+                                 4097, 262143, 262144, MAX_DELTA, MAX_DELTA + 1, 3 * MAX_DELTA + 5};
+  const uint32_t totalExpire = sizeof(expireList) / sizeof(expireList[0]);
+  TimerWheel     cascadeWheel;
+  WheelTimeout   cascadeList[totalExpire] = {};
+  for (uint32_t index = 0; index < totalExpire; ++index) {
+    wheelTimeoutAdd(cascadeWheel, cascadeList[index], expireList[index], 0, nullptr);
+  }
+  uint64_t nextTick  = 0;
+  uint32_t totalStep = 0;
+  while (cascadeWheel.nextTickGet(nextTick) && (totalStep < 1000)) {
+    cascadeWheel.advance(nextTick);
+    ++totalStep;
+  }
+  uint32_t totalWrongRun = 0;
+  for (uint32_t index = 0; index < totalExpire; ++index) {
+    const WheelTimeout &timeout = cascadeList[index];
+    if ((1 != timeout.totalRun) || (expireList[index] != timeout.runTick)) { ++totalWrongRun; }
+  }
+  simCheck(0 == totalWrongRun, name, "every level and parked timeout ran once on its tick");
+  simCheck(0 == cascadeWheel.totalArmedGet(), name, "nothing left armed");
+
+  // two timeouts due on the same tick cancel each other so whichever runs first is the only one,
+  // a callback cancels one on an upper level and a periodic one cancels itself, all in one
+  // advance()
+  TimerWheel   cancelWheel;
+  WheelTimeout cancelList[5] = {};
+  cancelWheel.restart(1000);
+  wheelTimeoutAdd(cancelWheel, cancelList[0], 1100, 0, &cancelList[1].entry);
+  wheelTimeoutAdd(cancelWheel, cancelList[1], 1100, 0, &cancelList[0].entry);
+  wheelTimeoutAdd(cancelWheel, cancelList[3], 6000, 0, nullptr);
+  wheelTimeoutAdd(cancelWheel, cancelList[2], 1200, 0, &cancelList[3].entry);
+  wheelTimeoutAdd(cancelWheel, cancelList[4], 1010, 10, &cancelList[4].entry);
+  cancelWheel.advance(100000);
+  simCheck(1 == cancelList[0].totalRun + cancelList[1].totalRun,
+           name,
+           "timeout cancelled by one due on the same tick never ran");
+  simCheck((1 == cancelList[2].totalRun) && (0 == cancelList[3].totalRun),
+           name,
+           "timeout cancelled on an upper level never ran");
+  simCheck(1 == cancelList[4].totalRun, name, "periodic timeout cancelling itself ran once");
+  simCheck(0 == cancelWheel.totalArmedGet(), name, "cancelled timeouts disarmed");
+
+  // periodic ones across every level, advanced in uneven jumps then one long one
+  const uint64_t periodList[] = {7, 64, 5000, 300000};
+  const uint32_t totalPeriod  = sizeof(periodList) / sizeof(periodList[0]);
+  const uint64_t startTick    = 5;
+  const uint64_t endTick      = 2000005;
+  TimerWheel     periodicWheel;
+  WheelTimeout   periodicList[totalPeriod] = {};
+  periodicWheel.restart(startTick);
+  for (uint32_t index = 0; index < totalPeriod; ++index) {
+    wheelTimeoutAdd(periodicWheel,
+                    periodicList[index],
+                    startTick + periodList[index],
+                    periodList[index],
+                    nullptr);
+  }
+  for (uint64_t tick = startTick; tick < endTick / 2; tick += 37) { periodicWheel.advance(tick); }
+  periodicWheel.advance(endTick);
+  totalWrongRun = 0;
+  for (uint32_t index = 0; index < totalPeriod; ++index) {
+    const uint64_t      totalExpected = (endTick - startTick) / periodList[index];
+    const WheelTimeout &timeout       = periodicList[index];
+    if ((totalExpected != timeout.totalRun) ||
+        (startTick + totalExpected * periodList[index] != timeout.runTick)) {
+      ++totalWrongRun;
+    }
+  }
+  simCheck(0 == totalWrongRun, name, "periodic timeouts ran once per period");
+}
+
+/**
+ * @brief check the text, the timing and the strobes of a displayWrite in one bus mode
+ */
+static void writeModeCheck(const LcdConfig &lcdConfig, const char *name) {
+  LcdSimFixture fixture(lcdConfig);
+  LcdDriver &   lcdDriver = fixture.driverGet();
+  lcdDriver.enable();
+
+  fixture.statReset();
+  const uint64_t startTime = simTimeGet();
+  lcdDriver.displayWrite("Temp: 23.5 C\nHumidity: 45 %");
+  const uint64_t returnTime = simTimeGet() - startTime;
+  lcdDriver.flush();
+  const uint64_t    writeTime = simTimeGet() - startTime;
+  const Hd44780Stat lcdStat   = fixture.statGet();
+
+  simCheck("Temp: 23.5 C\nHumidity: 45 %" == fixture.screenGet(), name, "text shown");
+  simCheck(0 == lcdStat.busyViolation + lcdStat.timingViolation, name, "no violations");
+  // a strobe per byte on the 8-bit bus, one per nibble on the 4-bit bus
+  const uint64_t totalByte =
+      lcdStat.instructionWrite + lcdStat.dataWrite + lcdStat.dataRead + lcdStat.statusRead;
+  simCheck(lcdStat.enStrobe == totalByte * (lcdConfig.is8BitBus ? 1 : 2), name, "strobes per byte");
+  if (lcdConfig.isAsync) {
+    simCheck(returnTime * 10 < writeTime, name, "returned b4 a tenth of the bus time");
+  }
+  // with R/W tied low a read would only see the bus floating
+  if (lcdConfig.isWriteOnly) {
+    simCheck(0 == lcdStat.statusRead + lcdStat.dataRead, name, "nothing read back");
+  }
+}
+
+static void writeModeTest(const char *name) {
+  writeModeCheck(lcdConfigDefaultGet(PACING_FIXED_DELAY), "PACING_FIXED_DELAY");
+  writeModeCheck(lcdConfigDefaultGet(PACING_BUSY_FLAG), "PACING_BUSY_FLAG");
+  writeModeCheck(lcdConfig8BitGet(PACING_BUSY_FLAG), "PACING_BUSY_FLAG_8BIT");
+  // the driver falls back to PACING_FIXED_DELAY on its own
+  LcdConfig lcdConfig   = lcdConfigDefaultGet(PACING_BUSY_FLAG);
+  lcdConfig.isWriteOnly = true;
+  writeModeCheck(lcdConfig, "WRITE_ONLY");
+  lcdConfig         = lcdConfigDefaultGet(PACING_BUSY_FLAG);
+  lcdConfig.isAsync = true;
+  writeModeCheck(lcdConfig, "ASYNC");
+  lcdConfig         = lcdConfig8BitGet(PACING_BUSY_FLAG);
+  lcdConfig.isAsync = true;
+  writeModeCheck(lcdConfig, "ASYNC_8BIT");
+  writeModeCheck(lcdConfigSinglePortGet(), "ASYNC_DMA");
+}
+
+/**
+ * @brief a panel and what it shows after the geometry test text
+ */
+typedef struct {
+  const char *name;
+  LcdGeometry geometry;
+  const char *screen;  //!< like lcdScreenGet()
+} TestGeometry;
+
+static void geometryTest(const char *name) {
+  // the first row wraps on every panel, the newline then starts a new row, a newline on the last
+  // row starts it over and text past the end of the last row is dropped
+  const TestGeometry testGeometryList[] = {
+      {"8x1", LCD_GEOMETRY_8X1, "newline"},
+      {"16x1", LCD_GEOMETRY_16X1, "newline skips a"},
+      {"16x2", LCD_GEOMETRY_16X2, "Rows wrap by the\nnewline skips a"},
+      {"16x4", LCD_GEOMETRY_16X4, "Rows wrap by the\nmselves and\nnewline skips a\nrow, appended"},
+      {"20x2", LCD_GEOMETRY_20X2, "Rows wrap by themsel\nnewline skips a row,"},
+      {"20x4", LCD_GEOMETRY_20X4, "Rows wrap by themsel\nves and\nnewline skips a row,\n appended"},
+      {"40x2", LCD_GEOMETRY_40X2, "Rows wrap by themselves and\nnewline skips a row, appended"}};
+
+  for (const TestGeometry &testGeometry : testGeometryList) {
+    LcdConfig lcdConfig = lcdConfigDefaultGet(PACING_BUSY_FLAG);
+    lcdConfig.geometry  = testGeometry.geometry;
+    LcdSimFixture fixture(lcdConfig);
+    fixture.driverGet().enable();
+
+    fixture.statReset();
+    fixture.driverGet().displayWrite("Rows wrap by themselves and\nnewline skips a row");
+    fixture.driverGet().displayAppend(", appended");
+    simCheck(testGeometry.screen == fixture.screenGet(), testGeometry.name, "text shown");
+    simCheck(0 == fixture.statGet().timingViolation, testGeometry.name, "no violations");
+  }
+}
+
+/**
+ * @brief write a full screen without a newline
+ * @return uint64_t nanosec per character
+ */
+static uint64_t fullScreenCheck(const LcdConfig &lcdConfig, const char *name) {
+  LcdSimFixture fixture(lcdConfig);
+  fixture.driverGet().enable();
+
+  // the screen shows the text split at the row ends
+  char        text[LCD_MAX_PRINT_STRING];
+  uint32_t    textLen = 0;
+  std::string screen;
+  for (uint32_t row = 0; row < lcdConfig.geometry.totalRow; ++row) {
+    if (0 != row) { screen += '\n'; }
+    for (uint32_t column = 0; column < lcdConfig.geometry.totalColumn; ++column) {
+      text[textLen++] = 'A' + (row * 7 + column) % 26;
+      screen += text[textLen - 1];
+    }
+  }
+  text[textLen] = 0;
+
+  fixture.statReset();
+  const uint64_t startTime = simTimeGet();
+  fixture.driverGet().displayWrite(text);
+  const uint64_t    writeTime = simTimeGet() - startTime;
+  const Hd44780Stat lcdStat   = fixture.statGet();
+
+  simCheck(screen == fixture.screenGet(), name, "text shown");
+  simCheck(0 == lcdStat.busyViolation + lcdStat.timingViolation, name, "no violations");
+  // each controller only gets the characters of its own rows
+  for (uint32_t controller = 0; controller < lcdConfig.totalController; ++controller) {
+    simCheck(fixture.lcdSimGet(controller).statGet().dataWrite ==
+                 textLen / lcdConfig.totalController,
+             name,
+             "characters split between the controllers");
+  }
+  return writeTime / textLen;
+}
+
+static void dualControllerTest(const char *name) {
+  // a single 40x2 controller, then the 2 controllers of a 40x4 that take turns, one sends while the
+  // other executes so a character takes well under the time it takes on the 40x2
+  for (const LcdPacingMode pacingMode : {PACING_FIXED_DELAY, PACING_BUSY_FLAG}) {
+    LcdConfig lcdConfig = lcdConfigDefaultGet(pacingMode);
+    lcdConfig.geometry  = LCD_GEOMETRY_40X2;
+    const uint64_t singleCharTime = fullScreenCheck(lcdConfig, name);
+    const uint64_t dualCharTime   = fullScreenCheck(lcdConfig40x4Get(pacingMode), name);
+    simCheck(dualCharTime * 10 < singleCharTime * 6, name, "40x4 under 0.6 of the 40x2 time");
+  }
+}
+
+/**
+ * @brief a step of the broadcast test
+ */
+typedef struct {
+  const char *name;
+  uint32_t    displayMask;  //!< given to displaySelect()
+  const char *text;
+} TestBroadcastStep;
+
+static void broadcastCheck(const LcdPacingMode &pacingMode, const char *name) {
+  static const uint32_t TOTAL_DISPLAY = 3;
+  const LcdConfig       lcdConfig     = lcdConfigBroadcastGet(pacingMode, TOTAL_DISPLAY);
+  LcdSimFixture         fixture(lcdConfig);
+  LcdDriver &           lcdDriver = fixture.driverGet();
+  lcdDriver.enable();
+
+  // the last display is given its own text and catches up with the others on the next write
+  const TestBroadcastStep stepList[] = {{"all", 0x7, "Cabinet 1\nTemp: 23.5 C"},
+                                        {"display 2", 0x4, "Service door\nopen"},
+                                        {"all", 0x7, "Cabinet 1\nTemp: 23.6 C"}};
+  std::string             screenList[TOTAL_DISPLAY];
+  for (const TestBroadcastStep &step : stepList) {
+    fixture.statReset();
+    lcdDriver.displaySelect(step.displayMask);
+    lcdDriver.displayWrite(step.text);
+    const Hd44780Stat lcdStat = fixture.statGet();
+    simCheck(0 == lcdStat.busyViolation + lcdStat.timingViolation, name, "no violations");
+
+    // the displays in the mask show the text, the others keep theirs
+    for (uint32_t display = 0; display < TOTAL_DISPLAY; ++display) {
+      Hd44780Sim &lcdSim = fixture.lcdSimGet(display);
+      if (step.displayMask & BIT(display)) { screenList[display] = step.text; }
+      simCheck(screenList[display] == lcdScreenGet(lcdSim, lcdConfig.geometry),
+               name,
+               "text shown on the selected displays only");
+    }
+  }
+}
+
+static void broadcastTest(const char *name) {
+  broadcastCheck(PACING_FIXED_DELAY, name);
+  broadcastCheck(PACING_BUSY_FLAG, name);
+}
+
+/**
+ * @brief a timeout armed on the GeneralTimer wheel and what its runs saw
+ */
+typedef struct {
+  TimerWheelEntry entry;
+  uint64_t        dueTime;      //!< virtual nanosec
+  uint64_t        period;       //!< nanosec, 0 for one shot
+  uint32_t        totalRun;     //!< callbacks so far
+  uint32_t        totalEarly;   //!< callbacks that ran b4 the due time
+  bool            isCancelled;  //!< cancelled while still armed
+} TestTimeout;
+
+static void testTimeoutCallback(void *context) {
+  TestTimeout &timeout = *(TestTimeout *)context;
+  ++timeout.totalRun;
+  if (simTimeGet() < timeout.dueTime) { ++timeout.totalEarly; }
+  timeout.dueTime += timeout.period;
+}
+
+static void generalTimerTimeoutTest(const char *name) {
+  static const uint32_t TOTAL_ONE_SHOT = 256;
+  static const uint32_t TOTAL_PERIODIC = 16;
+  static TestTimeout    timeoutList[TOTAL_ONE_SHOT + TOTAL_PERIODIC];
+
+  simReset();
+  simListenerClear();
+  simTimerIsrSet(WTIMER0_BASE, GeneralTimerIntHandler);
+  GeneralTimer generalTimer(UNIT_NANOSEC);
+
+  // one shots spread over 50 ms with a fixed pseudo random sequence, periodic ones every 1-16 ms
+  uint32_t randomValue = 1;
+  for (uint32_t index = 0; index < TOTAL_ONE_SHOT + TOTAL_PERIODIC; ++index) {
+    TestTimeout &timeout = timeoutList[index];
+    randomValue          = randomValue * 1103515245 + 12345;
+    const uint64_t delay = (index < TOTAL_ONE_SHOT)
+                               ? ((uint64_t)(randomValue >> 8) * 50000000) >> 24
+                               : (index - TOTAL_ONE_SHOT + 1) * 1000000;
+    timeout         = TestTimeout();
+    timeout.period  = (index < TOTAL_ONE_SHOT) ? 0 : delay;
+    timeout.dueTime = simTimeGet() + delay;
+    generalTimer.timeoutAdd(timeout.entry, delay, timeout.period, testTimeoutCallback, &timeout);
+  }
+
+  // some one shots are cancelled at 20 ms, the periodic ones at 100 ms
+  simTimeAdvance(20000000);
+  for (uint32_t index = 0; index < TOTAL_ONE_SHOT; index += 4) {
+    timeoutList[index].isCancelled = TimerWheel::isArmed(timeoutList[index].entry);
+    GeneralTimer::timeoutCancel(timeoutList[index].entry);
+  }
+  simTimeAdvance(80000000);
+  for (uint32_t index = TOTAL_ONE_SHOT; index < TOTAL_ONE_SHOT + TOTAL_PERIODIC; ++index) {
+    GeneralTimer::timeoutCancel(timeoutList[index].entry);
+  }
+
+  uint32_t totalEarly    = 0;
+  uint32_t totalWrongRun = 0;
+  for (uint32_t index = 0; index < TOTAL_ONE_SHOT + TOTAL_PERIODIC; ++index) {
+    const TestTimeout &timeout = timeoutList[index];
+    // cancelled one shots never run, the others once, periodic ones once per period until 100 ms
+    const uint64_t totalExpected =
+        (0 != timeout.period) ? 100000000 / timeout.period : (timeout.isCancelled ? 0 : 1);
+    totalEarly += timeout.totalEarly;
+    if (timeout.totalRun != totalExpected) { ++totalWrongRun; }
+  }
+  simCheck(0 == totalEarly, name, "no callback early");
+  simCheck(0 == totalWrongRun, name, "every timeout ran as often as expected");
+}
+
+static uint64_t testHeartbeatRun = 0;
+
+static void testHeartbeatCallback(void *context) { ++testHeartbeatRun; }
+
+static void sleepWaitTest(const char *name) {
+  LcdSimFixture fixture(lcdConfigDefaultGet(PACING_FIXED_DELAY));
+
+  // waits from 100 us sleep, a 1 ms heartbeat stands for the application's own interrupts
+  GeneralTimer generalTimer(UNIT_NANOSEC);
+  generalTimer.sleepWaitSet(100000);
+  TimerWheelEntry heartbeat = TimerWheelEntry();
+  testHeartbeatRun          = 0;
+  generalTimer.timeoutAdd(heartbeat, 1000000, 1000000, testHeartbeatCallback, nullptr);
+
+  const uint64_t startTime = simTimeGet();
+  fixture.statReset();
+  fixture.driverGet().enable();
+  const uint64_t enableTime = simTimeGet() - startTime;
+  GeneralTimer::timeoutCancel(heartbeat);
+  generalTimer.sleepWaitSet(0);
+
+  simCheck(0 == fixture.statGet().timingViolation, name, "no violations");
+  simCheck(simStatGet().sleepTime > enableTime / 2, name, "asleep most of enable");
+  simCheck(testHeartbeatRun >= enableTime / 1000000, name, "heartbeat kept running while asleep");
+}
+
+static void enableAsyncTest(const char *name) {
+  LcdSimFixture  fixture(lcdConfigDefaultGet(PACING_BUSY_FLAG));
+  LcdDriver &    lcdDriver = fixture.driverGet();
+  const uint64_t startTime = simTimeGet();
+  lcdDriver.enableAsync();
+
+  // 1 ms of work per loop stands for the rest of the system starting up
+  uint64_t stepTime = 0;
+  for (;;) {
+    const uint64_t stepStartTime = simTimeGet();
+    const bool     isEnabled     = lcdDriver.enableStep();
+    stepTime += simTimeGet() - stepStartTime;
+    if (isEnabled) { break; }
+    SysCtlDelay(SIM_CLOCK_HZ / 3000);
+  }
+  const uint64_t readyTime = simTimeGet() - startTime;
+
+  lcdDriver.displayWrite("Booted");
+  simCheck("Booted" == fixture.screenGet(), name, "text shown");
+  simCheck(0 == fixture.statGet().timingViolation, name, "no violations");
+  // the startup waits go to the other work instead of being spun in enableStep()
+  simCheck(stepTime * 10 < readyTime, name, "under a tenth of the startup in enableStep");
+}
+
+/**
+ * @brief a controller that the calibration is run against
+ */
+typedef struct {
+  const char *name;
+  SimTiming   simTiming;
+} TestController;
+
+static void calibrationTest(const char *name) {
+  // strict controllers latch garbage when the timing is too short, the slow one can't even take
+  // the datasheet timing that enable() uses
+  const TestController testControllerList[] = {{"datasheet", {230, 500, 40, 80, true}},
+                                               {"marginal", {690, 1500, 120, 240, true}},
+                                               {"slow", {900, 2000, 200, 350, true}}};
+  const uint32_t    totalTestController = sizeof(testControllerList) / sizeof(TestController);
+  const std::string text                = "Temp: 23.5 C\nHumidity: 45 %";
+  uint32_t          prevPercent         = 0;
+
+  for (uint32_t index = 0; index < totalTestController; ++index) {
+    const TestController &testController = testControllerList[index];
+    LcdSimFixture         fixture(lcdConfigDefaultGet(PACING_BUSY_FLAG));
+    LcdDriver &           lcdDriver = fixture.driverGet();
+    fixture.lcdSimGet(0).timingSet(testController.simTiming);
+
+    lcdDriver.enable();
+    const bool isCalibrated = lcdDriver.timingCalibrate();
+    fixture.statReset();
+    lcdDriver.displayWrite(text.c_str());
+
+    simCheck(isCalibrated, testController.name, "calibrated");
+    simCheck(text == fixture.screenGet(), testController.name, "text shown");
+    simCheck(0 == fixture.statGet().timingViolation, testController.name, "no violations");
+    // nothing fails for the datasheet controller, the others need more than it and the slow one
+    // the most
+    if (0 == index) {
+      simCheck(100 == lcdDriver.timingPercentGet(), name, "datasheet controller kept at 100 %");
+    } else {
+      simCheck(lcdDriver.timingPercentGet() > prevPercent,
+               testController.name,
+               "calibrated longer than the faster controller");
+    }
+    prevPercent = lcdDriver.timingPercentGet();
+  }
+}
+
+/**
+ * @brief custom character pattern that the record test uploads
+ */
+static uint8_t recordCharRowGet(const uint32_t &slot, const uint32_t &row) {
+  return (slot * 5 + row * 3) & 0x1f;
+}
+
+/**
+ * @brief one boot of the TivaC, enable() and the restore of the custom characters it does
+ * @return uint64_t custom character bytes that enable() uploaded
+ */
+static uint64_t recordBootCheck(Hd44780Sim &    lcdSim,
+                                const uint32_t &resetCause,
+                                const bool &    isLoadExpected,
+                                const char *    bootName) {
+  simResetCauseSet(resetCause);
+  lcdSim.statReset();
+
+  auto       lcdDriver = LcdDriver(lcdConfigDefaultGet(PACING_BUSY_FLAG));
+  const bool isLoaded  = lcdDriver.recordLoad();
+  lcdDriver.init();
+  lcdDriver.enable();
+  const uint64_t charUpload = lcdSim.statGet().dataWrite;
+
+  if (!isLoaded) {
+    lcdDriver.timingCalibrate();
+    for (uint32_t slot = 0; slot < MAX_TOTAL_CUSTOM_PATTERN; ++slot) {
+      uint8_t charPattern[CUSTOM_CHAR_PATTERN_LEN];
+      for (uint32_t row = 0; row < CUSTOM_CHAR_PATTERN_LEN; ++row) {
+        charPattern[row] = recordCharRowGet(slot, row);
+      }
+      lcdDriver.newCustomCharAdd(charPattern, slot);
+    }
+  }
+
+  bool isCharKept = true;
+  for (uint32_t slot = 0; slot < MAX_TOTAL_CUSTOM_PATTERN; ++slot) {
+    for (uint32_t row = 0; row < CUSTOM_CHAR_PATTERN_LEN; ++row) {
+      const uint8_t addr = slot * CUSTOM_CHAR_PATTERN_LEN + row;
+      isCharKept         = isCharKept && (recordCharRowGet(slot, row) == lcdSim.cgramGet(addr));
+    }
+  }
+  simCheck(isLoadExpected == isLoaded, bootName, "record loaded only after the first boot");
+  simCheck(isCharKept, bootName, "custom characters right");
+  simCheck(lcdDriver.recordSave(), bootName, "record saved");
+  return charUpload;
+}
+
+static void recordTest(const char *name) {
+  simReset();
+  simListenerClear();
+  Hd44780Sim lcdSim(lcdWiringGet(lcdConfigDefaultGet(PACING_BUSY_FLAG)));
+  simListenerAdd(&lcdSim);
+
+  // the EEPROM and the lcd both outlive a reset of the TivaC, only a power cycle empties the CGRAM
+  recordBootCheck(lcdSim, SYSCTL_CAUSE_POR, false, "first boot");
+  const uint64_t resetUpload = recordBootCheck(lcdSim, SYSCTL_CAUSE_EXT, true, "reset");
+  lcdSim.powerOn();
+  const uint64_t powerUpload = recordBootCheck(lcdSim, SYSCTL_CAUSE_POR, true, "power cycle");
+  simCheck(0 == resetUpload, name, "nothing uploaded after a reset");
+  simCheck(MAX_TOTAL_CUSTOM_PATTERN * CUSTOM_CHAR_PATTERN_LEN == powerUpload,
+           name,
+           "custom characters uploaded after a power cycle");
+
+  // a record only passes with its own magic, version and CRC
+  LcdRecord        record;
+  LcdRecordContent content;
+  memcpy(&record, simEepromGet() + LCD_EEPROM_ADDR, sizeof(record));
+  const bool isValid = lcdRecordDecode(record, content);
+  lcdRecordEncode(content, record);
+  LcdRecord changedRecord = record;
+  changedRecord.content.customCharList[3][2] ^= 0x01;
+  const bool isCorruptValid = lcdRecordDecode(changedRecord, content);
+  changedRecord = record;
+  ++changedRecord.version;
+  const bool isOldValid = lcdRecordDecode(changedRecord, content);
+  simCheck(isValid && !isCorruptValid && !isOldValid, name, "only valid record passes");
+  simResetCauseSet(SYSCTL_CAUSE_POR);
+}
+
+#ifdef LCD_TRACE
+static void traceOverflowTest(const char *name) {
+  simReset();
+  lcdTraceReset();
+  // one slot always stays free, RS ends at 0
+  for (uint32_t event = 0; event < LCD_TRACE_LEN - 1; ++event) {
+    lcdTracePinRecord(TRACE_SIGNAL_RS, event & 1);
+  }
+  lcdTracePinRecord(TRACE_SIGNAL_EN, 1);
+  simCheck(1 == lcdTraceDroppedGet(), name, "change dropped when full");
+
+  // once there is room the level that was dropped is recorded, repeating the one that was stored
+  // isn't
+  LcdTraceEvent event;
+  lcdTraceRead(event);
+  lcdTracePinRecord(TRACE_SIGNAL_RS, 0);
+  lcdTracePinRecord(TRACE_SIGNAL_EN, 1);
+  uint32_t totalEvent = 0;
+  while (lcdTraceRead(event)) { ++totalEvent; }
+  simCheck(LCD_TRACE_LEN - 1 == totalEvent, name, "only the new level recorded");
+  simCheck((TRACE_SIGNAL_EN == event.signal) && (1 == event.level),
+           name,
+           "dropped level recorded once there is room");
+  lcdTraceReset();
+}
+#endif
+
+static const SimTest simTestList[] = {{"busy_flag", busyFlagTest},
+                                      {"busy_flag_timeout", busyFlagTimeoutTest},
+                                      {"data_store", dataStoreTest},
+                                      {"text_run", textRunTest},
+                                      {"bus_direction", busDirectionTest},
+                                      {"async_queue", asyncQueueTest},
+                                      {"static_driver", staticDriverTest},
+                                      {"waveform", waveformTest},
+                                      {"timer_wheel", timerWheelTest},
+                                      {"write_mode", writeModeTest},
+                                      {"geometry", geometryTest},
+                                      {"dual_controller", dualControllerTest},
+                                      {"broadcast", broadcastTest},
+                                      {"general_timer_timeout", generalTimerTimeoutTest},
+                                      {"sleep_wait", sleepWaitTest},
+                                      {"enable_async", enableAsyncTest},
+                                      {"calibration", calibrationTest},
+                                      {"record", recordTest},
+#ifdef LCD_TRACE
+                                      {"trace_overflow", traceOverflowTest},
+#endif
+};
+
+int main(void) {
+  for (const SimTest &simTest : simTestList) {
+    const uint32_t failBefore = simCheckFailGet();
+    simTest.run(simTest.name);
+    printf("%s: %s\n", simTest.name, (failBefore == simCheckFailGet()) ? "passed" : "failed");
+  }
+  return (0 == simCheckFailGet()) ? 0 : 1;
+}
+
+#endif
@@ -0,0 +1,45 @@
+/**
+ * @brief reads what lcdTraceDump() printed on the UART and writes it as a VCD file, run as
+ * `lcd_trace_vcd [uart log] [vcd file]`, stdin and stdout are used for the ones left out
+ *
+ * @file lcd_trace_tool.cpp
+ * @author Khoi Trinh
+ * @date 2018-09-23
+ */
+
+// only part of the host build
+#ifdef LCD_HOST_SIM
+
+#include <cinttypes>
+#include <cstdio>
+
+#include "lcd_trace_vcd.hpp"
+
+using namespace tivasim;
+
+int main(int argc, char *argv[]) {
+  FILE *inFile  = (argc > 1) ? fopen(argv[1], "r") : stdin;
+  FILE *outFile = (argc > 2) ? fopen(argv[2], "w") : stdout;
+  if (!inFile || !outFile) {
+    fprintf(stderr, "usage: %s [uart log] [vcd file]\n", argv[0]);
+    return 1;
+  }
+
+  LcdTraceCapture capture;
+  if (!lcdTraceDumpParse(inFile, capture)) {
+    fprintf(stderr, "no complete lcd trace dump found\n");
+    return 1;
+  }
+  if (0 != capture.dropped) {
+    fprintf(stderr,
+            "the buffer was full, the last %" PRIu32 " events are missing\n",
+            capture.dropped);
+  }
+
+  lcdTraceVcdWrite(outFile, capture);
+  if (inFile != stdin) { fclose(inFile); }
+  if (outFile != stdout) { fclose(outFile); }
+  return 0;
+}
+
+#endif
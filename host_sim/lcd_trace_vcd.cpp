@@ -0,0 +1,105 @@
+/**
+ * @brief turns LCD_TRACE events into a VCD file
+ *
+ * @file lcd_trace_vcd.cpp
+ * @author Khoi Trinh
+ * @date 2018-09-23
+ */
+
+// only part of the host build
+#ifdef LCD_HOST_SIM
+
+#include "lcd_trace_vcd.hpp"
+
+#include <cinttypes>
+#include <cstring>
+
+using namespace lcddriver;
+
+namespace tivasim {
+
+static const uint32_t TRACE_LINE_LEN = 128;
+
+// VCD identifiers are printable characters, one per signal starting from '!'
+static char vcdIdGet(const uint8_t &signal) { return '!' + signal; }
+
+static bool traceEventParse(const char *line, LcdTraceEvent &event) {
+  uint64_t tick = 0;
+  char     name[32];
+  char     level = 0;
+  if (3 != sscanf(line, "%16" SCNx64 " %31s %c", &tick, name, &level)) { return false; }
+
+  event.tick   = tick;
+  event.signal = 0;
+  while ((event.signal < TRACE_TOTAL_SIGNAL) &&
+         (0 != strcmp(name, lcdTraceSignalNameGet(event.signal)))) {
+    ++event.signal;
+  }
+  if (TRACE_TOTAL_SIGNAL == event.signal) { return false; }
+
+  switch (level) {
+    case '0':
+      event.level = 0;
+      return true;
+    case '1':
+      event.level = 1;
+      return true;
+    case 'z':
+      event.level = LCD_TRACE_LEVEL_FLOAT;
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool lcdTraceDumpParse(FILE *file, LcdTraceCapture &capture) {
+  char line[TRACE_LINE_LEN];
+  bool isInDump = false;
+  capture.eventList.clear();
+
+  while (fgets(line, sizeof(line), file)) {
+    if (!isInDump) {
+      isInDump = (1 == sscanf(line, "lcd trace %" SCNu32, &capture.tickHz));
+      continue;
+    }
+    if (1 == sscanf(line, "lcd trace end %" SCNu32, &capture.dropped)) { return true; }
+
+    LcdTraceEvent event;
+    if (!traceEventParse(line, event)) { return false; }
+    capture.eventList.push_back(event);
+  }
+  return false;
+}
+
+void lcdTraceVcdWrite(FILE *file, const LcdTraceCapture &capture) {
+  fprintf(file, "$version lcd_trace_vcd $end\n");
+  if (0 != capture.dropped) {
+    fprintf(file, "$comment %" PRIu32 " events were dropped at the end $end\n", capture.dropped);
+  }
+  fprintf(file, "$timescale 1ns $end\n$scope module lcd $end\n");
+  for (uint8_t signal = 0; signal < TRACE_TOTAL_SIGNAL; ++signal) {
+    fprintf(file, "$var wire 1 %c %s $end\n", vcdIdGet(signal), lcdTraceSignalNameGet(signal));
+  }
+  fprintf(file, "$upscope $end\n$enddefinitions $end\n#0\n$dumpvars\n");
+  for (uint8_t signal = 0; signal < TRACE_TOTAL_SIGNAL; ++signal) {
+    fprintf(file, "x%c\n", vcdIdGet(signal));
+  }
+  fprintf(file, "$end\n");
+
+  static const char LEVEL_CHAR_LIST[] = {'0', '1', 'z'};
+  const uint64_t    startTick         = capture.eventList.empty() ? 0 : capture.eventList[0].tick;
+  uint64_t          prevTime          = 0;
+  for (const LcdTraceEvent &event : capture.eventList) {
+    // split so that long captures don't overflow
+    const uint64_t tick = event.tick - startTick;
+    const uint64_t time = (tick / capture.tickHz) * 1000000000 +
+                          (tick % capture.tickHz) * 1000000000 / capture.tickHz;
+    if (time != prevTime) { fprintf(file, "#%" PRIu64 "\n", time); }
+    prevTime = time;
+    fprintf(file, "%c%c\n", LEVEL_CHAR_LIST[event.level], vcdIdGet(event.signal));
+  }
+}
+
+}  // namespace tivasim
+
+#endif
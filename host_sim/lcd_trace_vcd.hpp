@@ -0,0 +1,48 @@
+/**
+ * @brief turns LCD_TRACE events into a VCD file that GTKWave can open, used by the demo and by the
+ * lcd_trace_vcd tool that reads what lcdTraceDump() printed on the UART
+ *
+ * @file lcd_trace_vcd.hpp
+ * @author Khoi Trinh
+ * @date 2018-09-23
+ */
+
+#ifndef _LCD_TRACE_VCD_HPP
+#define _LCD_TRACE_VCD_HPP
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "src/lcd_trace.hpp"
+
+namespace tivasim {
+
+/**
+ * @brief what lcdTraceDump() printed
+ */
+typedef struct {
+  uint32_t                              tickHz;  //!< clock of the GeneralTimer ticks
+  uint32_t                              dropped;
+  std::vector<lcddriver::LcdTraceEvent> eventList;
+} LcdTraceCapture;
+
+/**
+ * @brief find a dump in text, anything printed around it is skipped
+ * @param file where to read the text from
+ * @param capture filled with the dump
+ * @return false if there's no complete dump or a line of it can't be read
+ */
+bool lcdTraceDumpParse(FILE *file, LcdTraceCapture &capture);
+
+/**
+ * @brief write the events as a VCD file with a 1 ns timescale, the first event is at time 0 and
+ * every signal is unknown until its first event
+ * @param file where to write
+ * @param capture the events and their tick clock
+ */
+void lcdTraceVcdWrite(FILE *file, const LcdTraceCapture &capture);
+
+}  // namespace tivasim
+
+#endif
@@ -0,0 +1,16 @@
+/**
+ * @brief forced into every file of the host build, maps the ROM_ driverlib calls to the normal ones
+ * since there is no ROM on the host
+ *
+ * @file rom_sim.h
+ * @author Khoi Trinh
+ * @date 2018-09-23
+ */
+
+#ifndef _ROM_SIM_H
+#define _ROM_SIM_H
+
+#define ROM_SysCtlPeripheralEnable SysCtlPeripheralEnable
+#define ROM_SysCtlPeripheralReady SysCtlPeripheralReady
+
+#endif
@@ -0,0 +1,709 @@
+/**
+ * @brief host side definitions of the driverlib functions used by the project, the GPIO and timer
+ * peripherals are replaced with a simulated version running on a virtual clock
+ *
+ * @file tiva_sim.cpp
+ * @author Khoi Trinh
+ * @date 2018-09-23
+ */
+
+// only part of the host build, the TivaC build links against the real driverlib
+#ifdef LCD_HOST_SIM
+
+#include "tiva_sim.hpp"
+
+#include <cassert>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+// peripheral
+#include "driverlib/cpu.h"
+#include "driverlib/eeprom.h"
+#include "driverlib/gpio.h"
+#include "driverlib/interrupt.h"
+#include "driverlib/sw_crc.h"
+#include "driverlib/sysctl.h"
+#include "driverlib/timer.h"
+#include "driverlib/udma.h"
+#include "utils/uartstdio.h"
+
+// hardware
+#include "inc/hw_gpio.h"
+#include "inc/hw_ints.h"
+#include "inc/hw_memmap.h"
+#include "inc/hw_nvic.h"
+#include "inc/hw_udma.h"
+
+// application
+#include "general_timer/general_timer.hpp"
+
+namespace tivasim {
+
+/**
+ * @brief state of one simulated GPIO port
+ */
+typedef struct {
+  uint8_t  outputData;  //!< value written by the TivaC
+  uint8_t  directionOut;  //!< pins that are outputs
+  uint64_t writeCallList[256];  //!< GPIOPinWrite calls and stores by pin mask, reset with the stats
+} SimPort;
+
+static const uint32_t PORT_BASE_LIST[SIM_TOTAL_PORT] = {GPIO_PORTA_BASE,
+                                                        GPIO_PORTB_BASE,
+                                                        GPIO_PORTC_BASE,
+                                                        GPIO_PORTD_BASE,
+                                                        GPIO_PORTE_BASE,
+                                                        GPIO_PORTF_BASE};
+
+/**
+ * @brief state of a simulated timer A, it can run out once(one shot) or keep triggering a uDMA
+ * channel(periodic)
+ */
+typedef struct {
+  uint32_t timerBase;
+  uint32_t interrupt;   //!< timer A interrupt number in the NVIC
+  uint32_t dmaChannel;  //!< uDMA channel that timer A triggers
+  uint64_t loadValue;   //!< ticks
+  uint64_t timeout;     //!< virtual time when the timer runs out next
+  bool     isPeriodic;
+  bool     isRunning;
+  bool     isTimerIntEnabled;
+  bool     isDmaIntEnabled;
+  bool     isNvicEnabled;
+  bool     isDmaDonePending;  //!< the uDMA channel finished and raised the timer interrupt
+  void (*isr)(void);
+} SimTimer;
+
+static SimTimer timerList[] = {{TIMER0_BASE, INT_TIMER0A, UDMA_CH18_TIMER0A},
+                               {TIMER1_BASE, INT_TIMER1A, UDMA_CH18_TIMER1A},
+                               {TIMER2_BASE, INT_TIMER2A, UDMA_CH4_TIMER2A},
+                               {TIMER3_BASE, INT_TIMER3A, UDMA_CH2_TIMER3A}};
+
+static const uint32_t SIM_TOTAL_TIMER = sizeof(timerList) / sizeof(timerList[0]);
+
+/**
+ * @brief state of the match interrupt of wide timer 0, the free running counter read by
+ * GeneralTimer, it's only configured once so like the core registers simReset() leaves it alone
+ */
+typedef struct {
+  uint64_t matchValue;         //!< ticks
+  bool     isMatchArmed;       //!< the count hasn't reached the match yet
+  bool     isMatchIntEnabled;
+  bool     isNvicEnabled;
+  bool     isPending;          //!< the match was reached or IntPendSet was called
+  void (*isr)(void);
+} SimWideTimer;
+
+static SimWideTimer wideTimer;
+
+/**
+ * @brief state of a uDMA channel running a peripheral scatter gather list, each request moves one
+ * byte into a GPIO data register
+ */
+typedef struct {
+  uint32_t                channelAssign;  //!< UDMA_CHx_ value the channel is assigned to
+  bool                    isEnabled;
+  const tDMAControlTable *taskList;
+  uint32_t                totalTask;
+  uint32_t                taskIndex;
+  uint32_t                transferIndex;
+} SimDmaChannel;
+
+static SimDmaChannel dmaChannelList[32];
+
+static SimPort                    portList[SIM_TOTAL_PORT];
+static uint64_t                   currTime = 0;
+static SimStat                    simStat;
+static std::vector<PinListener *> listenerList;
+static uint8_t                    eepromData[SIM_EEPROM_LEN];
+static bool                       isEepromErased = false;
+static uint32_t                   resetCause     = SYSCTL_CAUSE_POR;
+
+static SimPort &portGet(const uint32_t &portBase) {
+  for (uint32_t port = 0; port < SIM_TOTAL_PORT; ++port) {
+    if (PORT_BASE_LIST[port] == portBase) { return portList[port]; }
+  }
+  assert(false && "unknown gpio port");
+  return portList[0];
+}
+
+static SimTimer *timerGet(const uint32_t &timerBase) {
+  for (uint32_t timer = 0; timer < SIM_TOTAL_TIMER; ++timer) {
+    if (timerList[timer].timerBase == timerBase) { return &timerList[timer]; }
+  }
+  return nullptr;
+}
+
+static uint32_t activeInterrupt   = 0;      // NVIC number of the running handler, 0 in thread mode
+static bool     isInterruptMasked = false;  // PRIMASK
+
+static void listenerNotify(void);
+
+// move one byte of the scatter gather list of a channel, return false once it's done
+static bool dmaTransfer(SimDmaChannel &dmaChannel) {
+  const tDMAControlTable &task = dmaChannel.taskList[dmaChannel.taskIndex];
+  assert(UDMA_SIZE_8 == (task.ui32Control & UDMA_CHCTL_SRCSIZE_M));
+  assert(UDMA_DST_INC_NONE == (task.ui32Control & UDMA_CHCTL_DSTINC_M));
+  const uint32_t totalTransfer =
+      ((task.ui32Control & UDMA_CHCTL_XFERSIZE_M) >> UDMA_CHCTL_XFERSIZE_S) + 1;
+  const uint8_t *srcBegin = (const uint8_t *)task.pvSrcEndAddr - (totalTransfer - 1);
+
+  // only masked GPIO data registers are supported as destination
+  const uintptr_t dstAddr = (uintptr_t)task.pvDstEndAddr;
+  SimPort &       port    = portGet(dstAddr & ~(uintptr_t)0xfff);
+  const uint8_t   pinMask = (dstAddr & 0x3fc) >> 2;
+  port.outputData = (port.outputData & ~pinMask) | (srcBegin[dmaChannel.transferIndex] & pinMask);
+  listenerNotify();
+
+  if (++dmaChannel.transferIndex == totalTransfer) {
+    dmaChannel.transferIndex = 0;
+    if (++dmaChannel.taskIndex == dmaChannel.totalTask) {
+      dmaChannel.isEnabled = false;
+      return false;
+    }
+  }
+  return true;
+}
+
+// play the periodic timer uDMA requests that happen before endTime at their own time
+static void dmaRun(const uint64_t &endTime) {
+  for (uint32_t timer = 0; timer < SIM_TOTAL_TIMER; ++timer) {
+    SimTimer &     simTimer   = timerList[timer];
+    SimDmaChannel &dmaChannel = dmaChannelList[simTimer.dmaChannel & 0x1f];
+    while (simTimer.isRunning && simTimer.isPeriodic && (simTimer.timeout <= endTime)) {
+      if (simTimer.timeout > currTime) { currTime = simTimer.timeout; }
+      simTimer.timeout += (simTimer.loadValue + 1) * 1000 / (SIM_CLOCK_HZ / 1000000);
+      if ((dmaChannel.channelAssign == simTimer.dmaChannel) && dmaChannel.isEnabled &&
+          !dmaTransfer(dmaChannel)) {
+        simTimer.isDmaDonePending = true;
+      }
+    }
+  }
+}
+
+// count of the free running wide timer
+static uint64_t wideTickGet(void) { return currTime * (SIM_CLOCK_HZ / 1000000) / 1000; }
+
+// virtual time when the wide timer count reaches the match, false if it never will
+static bool wideMatchTimeGet(uint64_t &matchTime) {
+  static const uint64_t TICK_PER_MICROSEC = SIM_CLOCK_HZ / 1000000;
+  if (!wideTimer.isMatchArmed || (wideTimer.matchValue > UINT64_MAX / 1000)) { return false; }
+  matchTime = (wideTimer.matchValue * 1000 + TICK_PER_MICROSEC - 1) / TICK_PER_MICROSEC;
+  return true;
+}
+
+// the wide timer count reached the match since the last check
+static void wideMatchCheck(void) {
+  if (wideTimer.isMatchArmed && (wideTickGet() >= wideTimer.matchValue)) {
+    wideTimer.isMatchArmed = false;
+    if (wideTimer.isMatchIntEnabled) { wideTimer.isPending = true; }
+  }
+}
+
+static bool timerTimeoutIsPending(const SimTimer &simTimer) {
+  return simTimer.isRunning && !simTimer.isPeriodic && (currTime >= simTimer.timeout) &&
+         simTimer.isTimerIntEnabled;
+}
+
+static bool timerDmaDoneIsPending(const SimTimer &simTimer) {
+  return simTimer.isDmaDonePending && simTimer.isDmaIntEnabled;
+}
+
+// something would run if interrupts weren't masked, this is what ends a WFI
+static bool interruptIsPending(void) {
+  wideMatchCheck();
+  if (wideTimer.isPending && wideTimer.isNvicEnabled) { return true; }
+  for (uint32_t timer = 0; timer < SIM_TOTAL_TIMER; ++timer) {
+    const SimTimer &simTimer = timerList[timer];
+    if ((timerTimeoutIsPending(simTimer) || timerDmaDoneIsPending(simTimer)) &&
+        simTimer.isNvicEnabled) {
+      return true;
+    }
+  }
+  return false;
+}
+
+static void interruptRun(const uint32_t &interrupt, void (*isr)(void)) {
+  ++simStat.interruptCall;
+  activeInterrupt = interrupt;
+  isr();
+  activeInterrupt = 0;
+}
+
+// run the handlers of the timers that ran out, interrupts don't nest
+static void interruptCheck(void) {
+  if ((0 != activeInterrupt) || isInterruptMasked) { return; }
+
+  bool isAnyRun = true;
+  while (isAnyRun) {
+    isAnyRun = false;
+    wideMatchCheck();
+    if (wideTimer.isPending && wideTimer.isNvicEnabled && wideTimer.isr) {
+      wideTimer.isPending = false;
+      interruptRun(INT_WTIMER0A, wideTimer.isr);
+      isAnyRun = true;
+    }
+
+    for (uint32_t timer = 0; timer < SIM_TOTAL_TIMER; ++timer) {
+      SimTimer & simTimer  = timerList[timer];
+      const bool isTimeout = timerTimeoutIsPending(simTimer);
+      const bool isDmaDone = timerDmaDoneIsPending(simTimer);
+      if ((isTimeout || isDmaDone) && simTimer.isNvicEnabled && simTimer.isr) {
+        if (isTimeout) { simTimer.isRunning = false; }
+        simTimer.isDmaDonePending = false;
+        interruptRun(simTimer.interrupt, simTimer.isr);
+        isAnyRun = true;
+      }
+    }
+  }
+}
+
+// earliest virtual time after now that a timer runs out, triggers a uDMA request or matches
+static bool nextEventTimeGet(uint64_t &eventTime) {
+  bool isFound = wideMatchTimeGet(eventTime);
+  for (uint32_t timer = 0; timer < SIM_TOTAL_TIMER; ++timer) {
+    const SimTimer &simTimer = timerList[timer];
+    if (simTimer.isRunning && (!isFound || (simTimer.timeout < eventTime))) {
+      eventTime = simTimer.timeout;
+      isFound   = true;
+    }
+  }
+  return isFound;
+}
+
+static void timeAdvance(const uint64_t &timeNanoSec) {
+  const uint64_t endTime   = currTime + timeNanoSec;
+  uint64_t       matchTime = 0;
+  // stop at the wide timer match so its handler isn't late
+  while (wideMatchTimeGet(matchTime) && (matchTime < endTime)) {
+    dmaRun(matchTime);
+    if (matchTime > currTime) { currTime = matchTime; }
+    wideMatchCheck();
+    interruptCheck();
+  }
+  dmaRun(endTime);
+  currTime = endTime;
+  interruptCheck();
+}
+
+static void listenerNotify(void) {
+  for (auto listener : listenerList) { listener->pinChanged(currTime); }
+}
+
+uint64_t simTimeGet(void) { return currTime; }
+
+void simTimeAdvance(const uint64_t &timeNanoSec) { timeAdvance(timeNanoSec); }
+
+void simReset(void) {
+  for (uint32_t port = 0; port < SIM_TOTAL_PORT; ++port) {
+    portList[port].outputData   = 0;
+    portList[port].directionOut = 0;
+  }
+  for (uint32_t timer = 0; timer < SIM_TOTAL_TIMER; ++timer) {
+    timerList[timer].isRunning         = false;
+    timerList[timer].isTimerIntEnabled = false;
+    timerList[timer].isNvicEnabled     = false;
+    timerList[timer].isDmaIntEnabled   = false;
+    timerList[timer].isDmaDonePending  = false;
+  }
+  for (uint32_t channel = 0; channel < 32; ++channel) { dmaChannelList[channel] = SimDmaChannel(); }
+  currTime          = 0;
+  isInterruptMasked = false;
+  simStatReset();
+}
+
+void simTimerIsrSet(const uint32_t &timerBase, void (*isr)(void)) {
+  if (WTIMER0_BASE == timerBase) {
+    wideTimer.isr = isr;
+    return;
+  }
+  SimTimer *simTimer = timerGet(timerBase);
+  assert(simTimer && "only timer 0-3 and wide timer 0 are simulated");
+  simTimer->isr = isr;
+}
+
+void simListenerAdd(PinListener *listener) { listenerList.push_back(listener); }
+
+uint8_t *simEepromGet(void) {
+  if (!isEepromErased) {
+    memset(eepromData, 0xff, sizeof(eepromData));
+    isEepromErased = true;
+  }
+  return eepromData;
+}
+
+void simResetCauseSet(const uint32_t &cause) { resetCause = cause; }
+
+void simListenerClear(void) { listenerList.clear(); }
+
+bool simPinIsOutput(const uint32_t &portBase, const uint8_t &pinMask) {
+  return portGet(portBase).directionOut & pinMask;
+}
+
+uint64_t simPinWriteGet(const uint32_t &portBase, const uint8_t &pinMask) {
+  const SimPort &port      = portGet(portBase);
+  uint64_t       writeCall = 0;
+  for (uint32_t writeMask = 0; writeMask < 256; ++writeMask) {
+    if (writeMask & pinMask) { writeCall += port.writeCallList[writeMask]; }
+  }
+  return writeCall;
+}
+
+bool simPinLevelGet(const uint32_t &portBase, const uint8_t &pinMask) {
+  const SimPort &port = portGet(portBase);
+  if (port.directionOut & pinMask) { return port.outputData & pinMask; }
+
+  for (auto listener : listenerList) {
+    if (listener->pinDrive(portBase) & pinMask) { return true; }
+  }
+  return false;
+}
+
+const SimStat &simStatGet(void) { return simStat; }
+
+void simStatReset(void) {
+  simStat = SimStat();
+  for (uint32_t port = 0; port < SIM_TOTAL_PORT; ++port) {
+    memset(portList[port].writeCallList, 0, sizeof(portList[port].writeCallList));
+  }
+}
+
+}  // namespace tivasim
+
+using namespace tivasim;
+
+/* GPIO */
+
+void GPIOPinWrite(uint32_t ui32Port, uint8_t ui8Pins, uint8_t ui8Val) {
+  SimPort &port   = portGet(ui32Port);
+  port.outputData = (port.outputData & ~ui8Pins) | (ui8Val & ui8Pins);
+  ++simStat.gpioWriteCall;
+  ++port.writeCallList[ui8Pins];
+  dmaRun(currTime + SIM_GPIO_CALL_NANOSEC);
+  currTime += SIM_GPIO_CALL_NANOSEC;
+  listenerNotify();
+  interruptCheck();
+}
+
+void simGpioRegWrite(uint32_t regAddr, uint8_t value) {
+  // bits 9:2 of the address mask the pins that the store changes
+  assert((GPIO_O_DATA == (regAddr & 0xc03)) && "only the masked data register is simulated");
+  const uint8_t pinMask = (regAddr >> 2) & 0xff;
+  SimPort &     port    = portGet(regAddr & ~0xfff);
+  port.outputData       = (port.outputData & ~pinMask) | (value & pinMask);
+  ++simStat.gpioWriteCall;
+  ++port.writeCallList[pinMask];
+  dmaRun(currTime + SIM_CORE_REG_NANOSEC);
+  currTime += SIM_CORE_REG_NANOSEC;
+  listenerNotify();
+  interruptCheck();
+}
+
+int32_t GPIOPinRead(uint32_t ui32Port, uint8_t ui8Pins) {
+  int32_t result = 0;
+  for (uint32_t pin = 0; pin < 8; ++pin) {
+    const uint8_t pinMask = 1 << pin;
+    if ((ui8Pins & pinMask) && simPinLevelGet(ui32Port, pinMask)) { result |= pinMask; }
+  }
+  ++simStat.gpioReadCall;
+  timeAdvance(SIM_GPIO_CALL_NANOSEC);
+  return result;
+}
+
+void GPIODirModeSet(uint32_t ui32Port, uint8_t ui8Pins, uint32_t ui32PinIO) {
+  SimPort &port = portGet(ui32Port);
+  if (GPIO_DIR_MODE_OUT == ui32PinIO) {
+    port.directionOut |= ui8Pins;
+  } else {
+    port.directionOut &= ~ui8Pins;
+  }
+  ++simStat.gpioDirCall;
+  dmaRun(currTime + SIM_GPIO_CALL_NANOSEC);
+  currTime += SIM_GPIO_CALL_NANOSEC;
+  listenerNotify();
+  interruptCheck();
+}
+
+void GPIOPadConfigSet(uint32_t ui32Port, uint8_t ui8Pins, uint32_t ui32Strength,
+                      uint32_t ui32PadType) {
+  timeAdvance(SIM_GPIO_CALL_NANOSEC);
+}
+
+void GPIOPinTypeGPIOInput(uint32_t ui32Port, uint8_t ui8Pins) {
+  // the real function also sets the pad, that is 3 register writes
+  GPIODirModeSet(ui32Port, ui8Pins, GPIO_DIR_MODE_IN);
+  GPIOPadConfigSet(ui32Port, ui8Pins, GPIO_STRENGTH_2MA, GPIO_PIN_TYPE_STD);
+}
+
+void GPIOPinTypeGPIOOutput(uint32_t ui32Port, uint8_t ui8Pins) {
+  GPIOPadConfigSet(ui32Port, ui8Pins, GPIO_STRENGTH_2MA, GPIO_PIN_TYPE_STD);
+  GPIODirModeSet(ui32Port, ui8Pins, GPIO_DIR_MODE_OUT);
+}
+
+/* System control */
+
+void SysCtlPeripheralEnable(uint32_t ui32Peripheral) {}
+
+bool SysCtlPeripheralReady(uint32_t ui32Peripheral) { return true; }
+
+void SysCtlClockSet(uint32_t ui32Config) {}
+
+uint32_t SysCtlClockGet(void) { return SIM_CLOCK_HZ; }
+
+uint32_t SysCtlResetCauseGet(void) { return resetCause; }
+
+void SysCtlDelay(uint32_t ui32Count) {
+  // each loop is 3 cycles
+  timeAdvance((uint64_t)ui32Count * 3 * 1000000000 / SIM_CLOCK_HZ);
+}
+
+/* Timer, TimerValueGet64 reads a free running up counter at system clock, timer 0-3 can also run
+ * out once after TimerEnable and raise their interrupt, wide timer 0 raises its match interrupt */
+
+void TimerConfigure(uint32_t ui32Base, uint32_t ui32Config) {
+  SimTimer *simTimer = timerGet(ui32Base);
+  if (simTimer) { simTimer->isPeriodic = (TIMER_CFG_PERIODIC == ui32Config); }
+}
+
+void TimerLoadSet(uint32_t ui32Base, uint32_t ui32Timer, uint32_t ui32Value) {
+  SimTimer *simTimer = timerGet(ui32Base);
+  if (simTimer) { simTimer->loadValue = ui32Value; }
+}
+
+void TimerLoadSet64(uint32_t ui32Base, uint64_t ui64Value) {}
+
+void TimerEnable(uint32_t ui32Base, uint32_t ui32Timer) {
+  SimTimer *simTimer = timerGet(ui32Base);
+  if (simTimer) {
+    // a periodic timer counts load + 1 ticks per period
+    const uint64_t totalTick = simTimer->loadValue + (simTimer->isPeriodic ? 1 : 0);
+    simTimer->timeout        = currTime + totalTick * 1000 / (SIM_CLOCK_HZ / 1000000);
+    simTimer->isRunning      = true;
+  }
+}
+
+void TimerDisable(uint32_t ui32Base, uint32_t ui32Timer) {
+  SimTimer *simTimer = timerGet(ui32Base);
+  if (simTimer) { simTimer->isRunning = false; }
+}
+
+void TimerIntEnable(uint32_t ui32Base, uint32_t ui32IntFlags) {
+  if ((WTIMER0_BASE == ui32Base) && (ui32IntFlags & TIMER_TIMA_MATCH)) {
+    wideTimer.isMatchIntEnabled = true;
+  }
+  SimTimer *simTimer = timerGet(ui32Base);
+  if (!simTimer) { return; }
+  if (ui32IntFlags & TIMER_TIMA_TIMEOUT) { simTimer->isTimerIntEnabled = true; }
+  if (ui32IntFlags & TIMER_TIMA_DMA) { simTimer->isDmaIntEnabled = true; }
+}
+
+void TimerIntClear(uint32_t ui32Base, uint32_t ui32IntFlags) {}
+
+void TimerMatchSet64(uint32_t ui32Base, uint64_t ui64Value) {
+  assert((WTIMER0_BASE == ui32Base) && "only the wide timer 0 match is simulated");
+  // like the real counter a match that was already passed is never reached
+  wideTimer.matchValue   = ui64Value;
+  wideTimer.isMatchArmed = ui64Value > wideTickGet();
+}
+
+uint64_t TimerValueGet64(uint32_t ui32Base) {
+  ++simStat.timerReadCall;
+  timeAdvance(SIM_TIMER_CALL_NANOSEC);
+  return wideTickGet();
+}
+
+/* uDMA, the control table isn't used, the scatter gather list is read straight from the caller */
+
+void uDMAEnable(void) {}
+
+void uDMAControlBaseSet(void *pControlTable) {}
+
+void uDMAChannelAssign(uint32_t ui32Mapping) {
+  dmaChannelList[ui32Mapping & 0x1f].channelAssign = ui32Mapping;
+}
+
+void uDMAChannelAttributeDisable(uint32_t ui32ChannelNum, uint32_t ui32Attr) {}
+
+void uDMAChannelScatterGatherSet(uint32_t ui32ChannelNum,
+                                 uint32_t ui32TaskCount,
+                                 void *   pvTaskList,
+                                 uint32_t ui32IsPeriphSG) {
+  SimDmaChannel &dmaChannel = dmaChannelList[ui32ChannelNum & 0x1f];
+  dmaChannel.taskList       = (const tDMAControlTable *)pvTaskList;
+  dmaChannel.totalTask      = ui32TaskCount;
+  dmaChannel.taskIndex      = 0;
+  dmaChannel.transferIndex  = 0;
+}
+
+void uDMAChannelEnable(uint32_t ui32ChannelNum) {
+  dmaChannelList[ui32ChannelNum & 0x1f].isEnabled = true;
+}
+
+uint32_t uDMAChannelModeGet(uint32_t ui32ChannelStructIndex) {
+  return dmaChannelList[ui32ChannelStructIndex & 0x1f].isEnabled ? UDMA_MODE_PER_SCATTER_GATHER
+                                                                  : UDMA_MODE_STOP;
+}
+
+void uDMAIntClear(uint32_t ui32ChanMask) {}
+
+/* NVIC */
+
+void IntEnable(uint32_t ui32Interrupt) {
+  if (INT_WTIMER0A == ui32Interrupt) { wideTimer.isNvicEnabled = true; }
+  for (uint32_t timer = 0; timer < SIM_TOTAL_TIMER; ++timer) {
+    if (timerList[timer].interrupt == ui32Interrupt) { timerList[timer].isNvicEnabled = true; }
+  }
+  interruptCheck();
+}
+
+void IntDisable(uint32_t ui32Interrupt) {
+  if (INT_WTIMER0A == ui32Interrupt) { wideTimer.isNvicEnabled = false; }
+  for (uint32_t timer = 0; timer < SIM_TOTAL_TIMER; ++timer) {
+    if (timerList[timer].interrupt == ui32Interrupt) { timerList[timer].isNvicEnabled = false; }
+  }
+}
+
+bool IntMasterEnable(void) {
+  const bool wasMasked = isInterruptMasked;
+  isInterruptMasked    = false;
+  interruptCheck();
+  return wasMasked;
+}
+
+bool IntMasterDisable(void) {
+  const bool wasMasked = isInterruptMasked;
+  isInterruptMasked    = true;
+  return wasMasked;
+}
+
+void IntPendSet(uint32_t ui32Interrupt) {
+  assert((INT_WTIMER0A == ui32Interrupt) && "only the wide timer 0 interrupt can be pended");
+  wideTimer.isPending = true;
+  interruptCheck();
+}
+
+/* Core, WFI skips the virtual clock ahead to the next timer event until an interrupt is pending,
+ * like on the TivaC a masked one still wakes the core */
+
+uint32_t CPUprimask(void) { return isInterruptMasked ? 1 : 0; }
+
+void CPUwfi(void) {
+  static const uint64_t MAX_SLEEP_NANOSEC = 3600ull * 1000000000;
+
+  const uint64_t startTime    = currTime;
+  const uint64_t totalRunPrev = simStat.interruptCall;
+  while (!interruptIsPending() && (totalRunPrev == simStat.interruptCall)) {
+    uint64_t eventTime = 0;
+    assert(nextEventTimeGet(eventTime) && (eventTime - startTime < MAX_SLEEP_NANOSEC) &&
+           "nothing is going to wake the core");
+    timeAdvance((eventTime > currTime) ? (eventTime - currTime) : 1);
+  }
+  simStat.sleepTime += currTime - startTime;
+}
+
+/* Core registers used by GeneralTimer, the DWT cycle counter and SysTick count the virtual clock,
+ * like a system reset simReset() doesn't touch them */
+
+static uint32_t coreDemcr         = 0;
+static uint32_t coreDwtControl    = 0;
+static uint32_t coreSysTickCtrl   = 0;
+static uint32_t coreSysTickReload = 0;
+static uint64_t coreSysTickStart  = 0;  // cycle when SysTick was last at its reload value
+
+static uint64_t coreCycleGet(void) { return currTime * (SIM_CLOCK_HZ / 1000000) / 1000; }
+
+uint32_t simCoreRegRead(const uint32_t &regAddr) {
+  switch (regAddr) {
+    case GENERAL_TIMER_DEMCR:
+      return coreDemcr;
+    case GENERAL_TIMER_DWT_CTRL:
+      return coreDwtControl;
+    case GENERAL_TIMER_DWT_CYCCNT:
+      assert((coreDemcr & GENERAL_TIMER_DEMCR_TRCENA) &&
+             (coreDwtControl & GENERAL_TIMER_DWT_CTRL_CYCCNTENA) && "CYCCNT is not counting");
+      timeAdvance(SIM_CORE_REG_NANOSEC);
+      return coreCycleGet();
+    case NVIC_INT_CTRL:
+      // TivaWare interrupt numbers are the vector numbers that VECACTIVE holds
+      return activeInterrupt;
+    case NVIC_ST_CTRL:
+      return coreSysTickCtrl;
+    case NVIC_ST_RELOAD:
+      return coreSysTickReload;
+    case NVIC_ST_CURRENT:
+      assert((coreSysTickCtrl & NVIC_ST_CTRL_ENABLE) && "SysTick is not counting");
+      timeAdvance(SIM_CORE_REG_NANOSEC);
+      return coreSysTickReload - (coreCycleGet() - coreSysTickStart) % (coreSysTickReload + 1);
+    default:
+      assert(0 && "core register is not simulated");
+      return 0;
+  }
+}
+
+void simCoreRegWrite(const uint32_t &regAddr, const uint32_t &value) {
+  switch (regAddr) {
+    case GENERAL_TIMER_DEMCR:
+      coreDemcr = value;
+      break;
+    case GENERAL_TIMER_DWT_CTRL:
+      // the NOCYCCNT bit is read only
+      coreDwtControl = value & ~GENERAL_TIMER_DWT_CTRL_NOCYCCNT;
+      break;
+    case NVIC_ST_CTRL:
+      coreSysTickCtrl = value;
+      break;
+    case NVIC_ST_RELOAD:
+      coreSysTickReload = value & NVIC_ST_RELOAD_M;
+      break;
+    case NVIC_ST_CURRENT:
+      // any write clears it, it reloads on the next cycle
+      coreSysTickStart = coreCycleGet() + 1;
+      break;
+    default:
+      assert(0 && "core register is not simulated");
+  }
+}
+
+/* EEPROM is a plain array, the time it takes isn't simulated */
+
+uint32_t EEPROMInit(void) { return EEPROM_INIT_OK; }
+
+uint32_t EEPROMSizeGet(void) { return SIM_EEPROM_LEN; }
+
+void EEPROMRead(uint32_t *pui32Data, uint32_t ui32Address, uint32_t ui32Count) {
+  assert((0 == ui32Address % 4) && (0 == ui32Count % 4));
+  assert(ui32Address + ui32Count <= SIM_EEPROM_LEN);
+  memcpy(pui32Data, simEepromGet() + ui32Address, ui32Count);
+}
+
+uint32_t EEPROMProgram(uint32_t *pui32Data, uint32_t ui32Address, uint32_t ui32Count) {
+  assert((0 == ui32Address % 4) && (0 == ui32Count % 4));
+  assert(ui32Address + ui32Count <= SIM_EEPROM_LEN);
+  memcpy(simEepromGet() + ui32Address, pui32Data, ui32Count);
+  return 0;
+}
+
+/* software CRC, bit by bit instead of the driverlib table */
+
+uint32_t Crc32(uint32_t ui32Crc, const uint8_t *pui8Data, uint32_t ui32Count) {
+  for (uint32_t index = 0; index < ui32Count; ++index) {
+    ui32Crc ^= pui8Data[index];
+    for (uint32_t bit = 0; bit < 8; ++bit) {
+      ui32Crc = (ui32Crc >> 1) ^ ((ui32Crc & 1) ? 0xedb88320 : 0);
+    }
+  }
+  return ui32Crc;
+}
+
+/* UART stdio goes straight to stdout */
+
+void UARTprintf(const char *pcString, ...) {
+  va_list argList;
+  va_start(argList, pcString);
+  vprintf(pcString, argList);
+  va_end(argList);
+}
+
+#endif
@@ -0,0 +1,168 @@
+/**
+ * @brief host side replacement for the TivaWare calls used by the LcdDriver, GPIO ports and timers
+ * are simulated against a virtual clock so the driver can run on a normal computer
+ *
+ * @file tiva_sim.hpp
+ * @author Khoi Trinh
+ * @date 2018-09-23
+ */
+
+#ifndef _TIVA_SIM_HPP
+#define _TIVA_SIM_HPP
+
+#include <cstdint>
+
+namespace tivasim {
+
+/**
+ * @brief clock frequency of the simulated TivaC, same as the 80 MHz used in main.cpp
+ */
+static const uint32_t SIM_CLOCK_HZ = 80000000;
+
+/**
+ * @brief virtual time spent by each simulated driverlib GPIO call, roughly the cycles that the real
+ * function call and register access take at 80 MHz
+ */
+static const uint64_t SIM_GPIO_CALL_NANOSEC = 250;
+
+/**
+ * @brief virtual time spent by each simulated driverlib timer read
+ */
+static const uint64_t SIM_TIMER_CALL_NANOSEC = 150;
+
+/**
+ * @brief virtual time spent by each read of the core cycle counter(DWT CYCCNT or SysTick), 2 cycles
+ * at 80 MHz
+ */
+static const uint64_t SIM_CORE_REG_NANOSEC = 25;
+
+/**
+ * @brief bytes of EEPROM that the TM4C123 has
+ */
+static const uint32_t SIM_EEPROM_LEN = 2048;
+
+/**
+ * @brief total GPIO ports that the TM4C123 has(A-F)
+ */
+static const uint32_t SIM_TOTAL_PORT = 6;
+
+/**
+ * @brief interface for anything that watches the simulated pins, like the lcd controller model
+ */
+class PinListener {
+ public:
+  virtual ~PinListener() {}
+
+  /**
+   * @brief called after any pin output or direction changes
+   * @param timeNanoSec virtual time when the change happened
+   */
+  virtual void pinChanged(const uint64_t &timeNanoSec) = 0;
+
+  /**
+   * @brief used when the TivaC reads a port, return the pins that the listener pulls high
+   * @param portBase the port being read, like GPIO_PORTB_BASE
+   * @return uint8_t mask of the pins driven high by the listener
+   */
+  virtual uint8_t pinDrive(const uint32_t &portBase) = 0;
+};
+
+/**
+ * @brief counters of the simulated driverlib calls, helpful for measuring the driver
+ */
+typedef struct {
+  uint64_t gpioWriteCall;  //!< GPIOPinWrite calls and stores to a masked data register
+  uint64_t gpioReadCall;   //!< GPIOPinRead calls
+  uint64_t gpioDirCall;    //!< calls changing pin direction or type
+  uint64_t timerReadCall;  //!< TimerValueGet/TimerValueGet64 calls
+  uint64_t interruptCall;  //!< simulated interrupts that ran
+  uint64_t sleepTime;      //!< virtual nanosec spent in WFI
+} SimStat;
+
+/**
+ * @brief return current virtual time in nanosec
+ */
+uint64_t simTimeGet(void);
+
+/**
+ * @brief move the virtual clock forward
+ * @param timeNanoSec how long to advance
+ */
+void simTimeAdvance(const uint64_t &timeNanoSec);
+
+/**
+ * @brief reset all ports, the clock and the stats to power on state, listeners are kept
+ */
+void simReset(void);
+
+/**
+ * @brief attach a listener to the GPIO ports, it will be notified about every change
+ * @param listener the listener to attach, must outlive the simulation
+ */
+void simListenerAdd(PinListener *listener);
+
+/**
+ * @brief remove all attached listeners
+ */
+void simListenerClear(void);
+
+/**
+ * @brief read the level that a pin is actually at, whether it's driven by the TivaC or a listener
+ * @param portBase port of the pin, like GPIO_PORTB_BASE
+ * @param pinMask the pin, like GPIO_PIN_6
+ * @return true if pin is high
+ */
+bool simPinLevelGet(const uint32_t &portBase, const uint8_t &pinMask);
+
+/**
+ * @brief get how many GPIOPinWrite calls or data register stores since simStatReset() wrote any of
+ * the pins, one writing several of them counts once
+ * @param portBase port of the pins, like GPIO_PORTB_BASE
+ * @param pinMask the pins, like GPIO_PIN_6 | GPIO_PIN_7
+ */
+uint64_t simPinWriteGet(const uint32_t &portBase, const uint8_t &pinMask);
+
+/**
+ * @brief check whether the TivaC drives the pin
+ * @param portBase port of the pin
+ * @param pinMask the pin
+ * @return true if pin is an output
+ */
+bool simPinIsOutput(const uint32_t &portBase, const uint8_t &pinMask);
+
+/**
+ * @brief hook up the handler of the timer interrupts, plays the role of the vector table
+ * Only the timer A timeout and the uDMA done interrupt of timer 0-3 and the match interrupt of
+ * wide timer 0 are simulated, the handler runs as soon as the virtual clock passes the timeout or
+ * the match or the uDMA finishes while the timer and NVIC interrupts are enabled
+ * @param timerBase the timer, like TIMER1_BASE or WTIMER0_BASE
+ * @param isr the handler, like LcdTxTimerIntHandler
+ */
+void simTimerIsrSet(const uint32_t &timerBase, void (*isr)(void));
+
+/**
+ * @brief get the simulated EEPROM, it's erased(all 0xff) at start and simReset() leaves it alone
+ * like the real one keeps its content across resets
+ * @return uint8_t* SIM_EEPROM_LEN bytes that can be changed directly
+ */
+uint8_t *simEepromGet(void);
+
+/**
+ * @brief set what SysCtlResetCauseGet() returns, SYSCTL_CAUSE_POR at start
+ * @param cause the SYSCTL_CAUSE_ flags
+ */
+void simResetCauseSet(const uint32_t &cause);
+
+/**
+ * @brief get the counters of the driverlib calls
+ */
+const SimStat &simStatGet(void);
+
+/**
+ * @brief reset the counters of the driverlib calls
+ */
+void simStatReset(void);
+
+}  // namespace tivasim
+
+#endif
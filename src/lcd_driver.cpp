@@ -14,6 +14,7 @@
 #include <cstring>
 
 // peripheral
+#include "driverlib/eeprom.h"
 #include "driverlib/gpio.h"
 #include "driverlib/interrupt.h"
 #include "driverlib/pin_map.h"
@@ -45,27 +46,86 @@ static void enableClockPeripheral(const uint32_t& clockMask) {
   }
 }
 
+/**
+ * @brief wait after each of the startup commands, the busy flag can't be checked until they are
+ * done
+ */
+static const uint32_t STARTUP_WAIT_LIST[] = {
+    LCD_FIRST_INIT_TIME_NANOSEC, LCD_SECOND_INIT_TIME_NANOSEC, LCD_EXEC_TIME_NANOSEC};
+static const uint32_t TOTAL_STARTUP_COMMAND = sizeof(STARTUP_WAIT_LIST) / sizeof(uint32_t);
+
 LcdDriver::LcdDriver(const LcdConfig& lcdconfig)
-    : _lcdConfig(lcdconfig),
+    : _totalBitPerPin(lcdconfig.is8BitBus ? 1 : 2),
+      _totalParallelPin(lcdconfig.is8BitBus ? 8 : 4),
+      _lcdConfig(lcdconfig),
+      _isParallelInput(false),
+      _isRegSelectData(false),
+      _isRegSelectKnown(false),
       _generalTimer(GeneralTimer(UNIT_NANOSEC)),
-      _totalBitPerPin(8 / TOTAL_PARALLEL_PIN) {}
+      _timingPercent(0),
+      _enableMask(BIT(0)),
+      _totalEnablePort(0),
+      _displayMask(BIT(lcdconfig.totalController) - 1),
+      _isBusyCheckPending(false),
+      _execStartStamp(0),
+      _execTime(0),
+      _cursorX(0),
+      _cursorY(0),
+      _addrCounter(0),
+      _isAddrCounterKnown(false),
+      _customCharUsed(0),
+      _isRecordLoaded(false),
+      _enableState(ENABLE_STATE_OFF),
+      _enableStartupSent(0),
+      _enableStepStamp(0),
+      _enableStepTime(0),
+      _txEngine(this),
+      _isAsyncActive(false),
+      _txTickPerMicrosec(0),
+      _isDmaBusy(false),
+      _dmaIdleCallback(nullptr),
+      _dmaIdleCallbackContext(nullptr) {
+  memset(_ddramShadow, LCD_SPACE_CHAR, sizeof(_ddramShadow));
+  memset(_customCharList, 0, sizeof(_customCharList));
+  memset(_controllerStateList, 0, sizeof(_controllerStateList));
+  // the queue doesn't know which controller a byte is for
+  assert((0 < _lcdConfig.totalController) && (_lcdConfig.totalController <= LCD_MAX_CONTROLLER));
+  assert((1 == _lcdConfig.totalController) || !_lcdConfig.isAsync);
+  geometryCheck();
+  dataPortCreate();
+  enablePortCreate();
+  // the busy flag can't be read without R/W
+  if (_lcdConfig.isWriteOnly) { _lcdConfig.pacingMode = PACING_FIXED_DELAY; }
+  const uint32_t timeScaler = (PACING_BUSY_FLAG == _lcdConfig.pacingMode) ? 1 : COM_TIME_SCALER;
+  timingSet(timeScaler * 100);
+}
+
+LcdDriver::~LcdDriver() {
+  flush();
+  txTimerDeinit();
+}
 
 void LcdDriver::init(void) {
+  LCD_INSTRUMENT_SCOPE(INSTRUMENT_INIT);
   // check, initialize clock, and configure pins
   pinDescCheck(_lcdConfig.regSelectPin);
   enableClockPeripheral(_lcdConfig.regSelectPin[PIN_DESC_CLOCK_INDEX]);
   pinModeSwitch(_lcdConfig.regSelectPin, false);
   pinPadConfig(_lcdConfig.regSelectPin);
 
-  pinDescCheck(_lcdConfig.readWritePin);
-  enableClockPeripheral(_lcdConfig.readWritePin[PIN_DESC_CLOCK_INDEX]);
-  pinModeSwitch(_lcdConfig.readWritePin, false);
-  pinPadConfig(_lcdConfig.readWritePin);
+  if (!_lcdConfig.isWriteOnly) {
+    pinDescCheck(_lcdConfig.readWritePin);
+    enableClockPeripheral(_lcdConfig.readWritePin[PIN_DESC_CLOCK_INDEX]);
+    pinModeSwitch(_lcdConfig.readWritePin, false);
+    pinPadConfig(_lcdConfig.readWritePin);
+  }
 
-  pinDescCheck(_lcdConfig.enablePin);
-  enableClockPeripheral(_lcdConfig.enablePin[PIN_DESC_CLOCK_INDEX]);
-  pinModeSwitch(_lcdConfig.enablePin, false);
-  pinPadConfig(_lcdConfig.enablePin);
+  for (uint32_t controller = 0; controller < _lcdConfig.totalController; ++controller) {
+    pinDescCheck(_lcdConfig.enablePinList[controller]);
+    enableClockPeripheral(_lcdConfig.enablePinList[controller][PIN_DESC_CLOCK_INDEX]);
+    pinModeSwitch(_lcdConfig.enablePinList[controller], false);
+    pinPadConfig(_lcdConfig.enablePinList[controller]);
+  }
 
   if (_lcdConfig.useBacklight) {
     pinDescCheck(_lcdConfig.backLightPin);
@@ -74,101 +134,414 @@ void LcdDriver::init(void) {
     pinPadConfig(_lcdConfig.backLightPin);
   }
 
-  for (uint32_t pin = 0; pin < TOTAL_PARALLEL_PIN; ++pin) {
+  // full pin setup is only done here, after that only the direction changes
+  for (uint32_t pin = 0; pin < _totalParallelPin; ++pin) {
     pinDescCheck(_lcdConfig.parallelPinList[pin]);
     enableClockPeripheral(_lcdConfig.parallelPinList[pin][PIN_DESC_CLOCK_INDEX]);
+    pinModeSwitch(_lcdConfig.parallelPinList[pin], false);
+    pinPadConfig(_lcdConfig.parallelPinList[pin]);
   }
+  _isParallelInput = false;
 
-  // switch all pins to input mode
-  parallelModeSwitch(false);
+  if (_lcdConfig.isAsync) { txTimerInit(); }
 }
 
 /* LCD bit banging and Communication Stuffs*/
 
 void LcdDriver::registerSelect(const bool& isDataReg) {
-  pinWrite(_lcdConfig.regSelectPin, isDataReg);
+  pinWrite(_lcdConfig.regSelectPin, isDataReg, TRACE_SIGNAL_RS);
+  _isRegSelectData  = isDataReg;
+  _isRegSelectKnown = true;
 }
 
 void LcdDriver::comSwitch(const bool& iscomEnabled) {
-  pinWrite(_lcdConfig.enablePin, iscomEnabled);
+  LCD_INSTRUMENT_SCOPE(INSTRUMENT_PIN_WRITE);
+#ifdef LCD_TRACE
+  for (uint32_t controller = 0; controller < _lcdConfig.totalController; ++controller) {
+    if (bit_get(_enableMask, BIT(controller))) {
+      LCD_TRACE_PIN(lcdTraceEnableSignalGet(controller), iscomEnabled);
+    }
+  }
+#endif
+  // the EN pins of a broadcast that share a port rise and fall in the same write
+  for (uint32_t port = 0; port < _totalEnablePort; ++port) {
+    const LcdEnablePort& enablePort = _enablePortList[port];
+    GPIOPinWrite(enablePort.portBase, enablePort.pinMask, iscomEnabled ? enablePort.pinMask : 0);
+  }
 }
 
 void LcdDriver::comModeSwitch(const bool& isReadMode) {
-  pinWrite(_lcdConfig.readWritePin, isReadMode);
+  // R/W is tied low
+  if (_lcdConfig.isWriteOnly) {
+    assert(!isReadMode);
+    return;
+  }
+  pinWrite(_lcdConfig.readWritePin, isReadMode, TRACE_SIGNAL_RW);
+}
+
+void LcdDriver::timingSet(const uint32_t& timePercent) {
+  assert(timePercent >= LCD_CALIBRATION_MIN_PERCENT);
+  _timingPercent        = timePercent;
+  _timing.addrSetupTime = LCD_ADDR_SETUP_TIME_NANOSEC * timePercent / 100;
+  _timing.dataSetupTime = LCD_DATA_SETUP_TIME_NANOSEC * timePercent / 100;
+  _timing.dataHoldTime  = LCD_DATA_HOLD_TIME_NANOSEC * timePercent / 100;
+  _timing.pulseWidth    = LCD_PULSE_WIDTH_NANOSEC * timePercent / 100;
+  _timing.minCycleTime  = LCD_MIN_CYCLE_TIME_NANOSEC * timePercent / 100;
+
+  // the interrupt keeps the bus timing but paces with the datasheet execution time, uDMA timing is
+  // exact so streaming always uses the datasheet bus timing
+  const uint32_t txTimePercent = _lcdConfig.isDmaStreamed ? 100 : timePercent;
+  LcdTxTiming    txTiming;
+  txTiming.addrSetupTime = LCD_ADDR_SETUP_TIME_NANOSEC * txTimePercent / 100 + TIVA_MAX_RISE_TIME;
+  txTiming.pulseWidth    = LCD_PULSE_WIDTH_NANOSEC * txTimePercent / 100 + TIVA_MAX_RISE_TIME;
+  txTiming.enableLowTime =
+      (LCD_MIN_CYCLE_TIME_NANOSEC - LCD_PULSE_WIDTH_NANOSEC) * txTimePercent / 100 +
+      TIVA_MAX_FALSE_TIME;
+  txTiming.execTime     = LCD_EXEC_TIME_NANOSEC;
+  txTiming.ramExecTime  = LCD_EXEC_TIME_NANOSEC + LCD_ADDR_UPDATE_TIME_NANOSEC;
+  txTiming.longExecTime = LCD_CLEAR_EXEC_TIME_NANOSEC;
+  _txEngine.configure(txTiming, _totalBitPerPin);
 }
 
 void LcdDriver::comSetup(const bool& isDataReg, const bool& isReadMode) {
-  const uint32_t waitTime = isReadMode ? LCD_DATA_READ_DELAY_NANOSEC : LCD_DATA_WRITE_WAIT_NANOSEC;
-  // setup so that the lcd knows that we want to talk with it
-  registerSelect(isDataReg);
-  comModeSwitch(isReadMode);
-  _generalTimer.wait(LCD_ADDR_SETUP_TIME_NANOSEC - TIVA_MAX_RISE_TIME);
+  LCD_INSTRUMENT_SCOPE(INSTRUMENT_COM_SETUP);
+  const uint32_t writeWaitTime = TIVA_MAX_RISE_TIME + _timing.pulseWidth - _timing.dataSetupTime;
+  const uint32_t waitTime      = isReadMode ? LCD_DATA_READ_DELAY_NANOSEC : writeWaitTime;
+  // setup so that the lcd knows that we want to talk with it, without R/W the setup time is only
+  // needed when RS changes
+  if (!_lcdConfig.isWriteOnly || !_isRegSelectKnown || (isDataReg != _isRegSelectData)) {
+    registerSelect(isDataReg);
+    comModeSwitch(isReadMode);
+    _generalTimer.wait(_timing.addrSetupTime - TIVA_MAX_RISE_TIME);
+  }
   comSwitch(true);
   _generalTimer.wait(waitTime);
 }
 
 void LcdDriver::comStop(void) {
-  _generalTimer.wait(LCD_DATA_SETUP_TIME_NANOSEC);
+  LCD_INSTRUMENT_SCOPE(INSTRUMENT_COM_STOP);
+  _generalTimer.wait(_timing.dataSetupTime);
   comSwitch(false);
-  _generalTimer.wait(LCD_DATA_HOLD_TIME_NANOSEC + TIVA_MAX_FALSE_TIME);
+  _generalTimer.wait(_timing.dataHoldTime + TIVA_MAX_FALSE_TIME);
 }
 
 void LcdDriver::comMaintain(const bool& isReadMode) {
-  const uint32_t waitTime = isReadMode ? LCD_DATA_READ_DELAY_NANOSEC : LCD_DATA_WRITE_WAIT_NANOSEC;
-  _generalTimer.wait(LCD_DATA_SETUP_TIME_NANOSEC);
+  LCD_INSTRUMENT_SCOPE(INSTRUMENT_COM_MAINTAIN);
+  const uint32_t writeWaitTime = TIVA_MAX_RISE_TIME + _timing.pulseWidth - _timing.dataSetupTime;
+  const uint32_t waitTime      = isReadMode ? LCD_DATA_READ_DELAY_NANOSEC : writeWaitTime;
+  _generalTimer.wait(_timing.dataSetupTime);
   comSwitch(false);
-  _generalTimer.wait(LCD_MIN_CYCLE_TIME_NANOSEC - LCD_DATA_WRITE_WAIT_NANOSEC);
+  _generalTimer.wait(_timing.minCycleTime - writeWaitTime);
   comSwitch(true);
   _generalTimer.wait(waitTime);
 }
 
+void LcdDriver::comResume(void) {
+  const uint32_t writeWaitTime = TIVA_MAX_RISE_TIME + _timing.pulseWidth - _timing.dataSetupTime;
+  comSwitch(true);
+  _generalTimer.wait(writeWaitTime);
+}
+
+void LcdDriver::busyWait(void) {
+  if (0 != _execTime) {
+    const uint64_t elapsedTime = _generalTimer.stopTimer(_execStartStamp);
+    if (elapsedTime < _execTime) { _generalTimer.wait(_execTime - elapsedTime); }
+    _execTime = 0;
+  }
+
+  if (!_isBusyCheckPending) { return; }
+  _isBusyCheckPending = false;
+
+  const uint32_t enableMask = _enableMask;
+  if (0 == (enableMask & (enableMask - 1))) {
+    busyPoll();
+    return;
+  }
+  // only one controller can drive the data pins so a broadcast is polled a display at a time
+  for (uint32_t controller = 0; controller < _lcdConfig.totalController; ++controller) {
+    if (!bit_get(enableMask, BIT(controller))) { continue; }
+    _enableMask = BIT(controller);
+    enablePortCreate();
+    busyPoll();
+  }
+  _enableMask = enableMask;
+  enablePortCreate();
+}
+
+void LcdDriver::busyPoll(void) {
+  uint64_t pollStartTime = 0;
+  _generalTimer.startTimer(pollStartTime);
+  while (lcdIsBusy()) {
+    if (_generalTimer.stopTimer(pollStartTime) > LCD_BUSY_POLL_TIMEOUT_NANOSEC) {
+      // controller is not answering, move on instead of hanging
+      break;
+    }
+  }
+}
+
+void LcdDriver::execPendingSet(const uint8_t& data, const bool& isDataReg) {
+  if (PACING_BUSY_FLAG == _lcdConfig.pacingMode) {
+    _isBusyCheckPending = true;
+  } else {
+    _generalTimer.startTimer(_execStartStamp);
+    _execTime = execTimeGet(data, isDataReg);
+  }
+}
+
+uint32_t LcdDriver::execTimeGet(const uint8_t& data, const bool& isDataReg) {
+  if (isDataReg) { return LCD_EXEC_TIME_NANOSEC + LCD_ADDR_UPDATE_TIME_NANOSEC; }
+  const bool isLongInstruction =
+      (LCD_CLEAR_COMMAND == data) || (LCD_RETURN_HOME_COMMAND == (data & 0xfe));
+  return isLongInstruction ? LCD_CLEAR_EXEC_TIME_NANOSEC : LCD_EXEC_TIME_NANOSEC;
+}
+
 void LcdDriver::configWrite(void) {
   uint8_t configData[5] = {0};
-  configData[0]         = functionSetCommandCreate(false, true, false);
+  configData[0] =
+      functionSetCommandCreate(_lcdConfig.is8BitBus, _lcdConfig.geometry.isTwoLineMode, false);
   configData[1]         = displayCommandCreate(true, true, true);
   configData[2]         = LCD_CLEAR_COMMAND;
   configData[3]         = entryModeCommandCreate(true, false);
 
-  dataWrite4Bit(LCD_BEGIN_COMMAND, false);
-  parallelDataWrite(configData, 4, false);
+  // the controller is still in 8 bit mode, a 4 bit bus switches it with a single strobe first, from
+  // here every config byte is paced on its own
+  if (!_lcdConfig.is8BitBus) {
+    for (uint32_t controller = 0; controller < _lcdConfig.totalController; ++controller) {
+      controllerSelect(BIT(controller));
+      singleStrobeWrite(LCD_BEGIN_COMMAND, true);
+      execPendingSet(LCD_BEGIN_COMMAND, false);
+    }
+  }
+  controllerAllWrite(configData, 4, false);
+  shadowClear();
 }
 
-void LcdDriver::enable(void) {
-  _generalTimer.wait(LCD_WARM_UP_TIME_NANOSEC);
+void LcdDriver::interfaceReset(void) {
+  for (uint32_t command = 0; command < TOTAL_STARTUP_COMMAND; ++command) {
+    startupCommandWrite();
+    _generalTimer.wait(STARTUP_WAIT_LIST[command]);
+  }
+  configWrite();
+}
 
-  dataWrite4Bit(LCD_STARTUP_COMMAND, true);
+void LcdDriver::startupCommandWrite(void) {
+  for (uint32_t controller = 0; controller < _lcdConfig.totalController; ++controller) {
+    controllerSelect(BIT(controller));
+    singleStrobeWrite(LCD_STARTUP_COMMAND, true);
+  }
+}
 
-  _generalTimer.wait(LCD_FIRST_INIT_TIME_NANOSEC);
+void LcdDriver::enable(void) {
+  LCD_INSTRUMENT_SCOPE(INSTRUMENT_ENABLE);
+  enableAsync();
+  while (!enableStep()) { _generalTimer.wait(enableWaitTimeGet()); }
+}
 
-  dataWrite4Bit(LCD_STARTUP_COMMAND, true);
-  _generalTimer.wait(LCD_SECOND_INIT_TIME_NANOSEC);
+void LcdDriver::enableAsync(void) {
+  // the lcd only needs to warm up if it lost its power along with the TivaC
+  const bool isWarmBoot =
+      _isRecordLoaded && !(SysCtlResetCauseGet() & (SYSCTL_CAUSE_POR | SYSCTL_CAUSE_BOR));
+  _enableState       = ENABLE_STATE_STARTUP;
+  _enableStartupSent = 0;
+  _enableStepTime    = isWarmBoot ? 0 : LCD_WARM_UP_TIME_NANOSEC;
+  _generalTimer.startTimer(_enableStepStamp);
+}
+
+bool LcdDriver::enableStep(void) {
+  LCD_INSTRUMENT_SCOPE(INSTRUMENT_ENABLE_STEP);
+  assert(ENABLE_STATE_OFF != _enableState);
+  if (ENABLE_STATE_READY == _enableState) { return true; }
+  if (0 != enableWaitTimeGet()) { return false; }
+
+  if (_enableStartupSent < TOTAL_STARTUP_COMMAND) {
+    startupCommandWrite();
+    _enableStepTime = STARTUP_WAIT_LIST[_enableStartupSent++];
+    _generalTimer.startTimer(_enableStepStamp);
+    return false;
+  }
 
-  dataWrite4Bit(LCD_STARTUP_COMMAND, true);
   configWrite();
+  if (_isRecordLoaded) { customCharRestore(); }
+  _isAsyncActive = _lcdConfig.isAsync;
+  _enableState   = ENABLE_STATE_READY;
+  return true;
+}
+
+uint32_t LcdDriver::enableWaitTimeGet(void) {
+  if (ENABLE_STATE_STARTUP != _enableState) { return 0; }
+  const uint64_t elapsedTime = _generalTimer.stopTimer(_enableStepStamp);
+  return (elapsedTime < _enableStepTime) ? (_enableStepTime - elapsedTime) : 0;
+}
+
+void LcdDriver::customCharRestore(void) {
+  uint8_t    cgramData[MAX_TOTAL_CUSTOM_PATTERN][CUSTOM_CHAR_PATTERN_LEN];
+  const bool isCgramRead = !_lcdConfig.isWriteOnly;
+  for (uint32_t controller = 0; controller < _lcdConfig.totalController; ++controller) {
+    controllerSelect(BIT(controller));
+    if (isCgramRead) { ramDataRead(&cgramData[0][0], sizeof(cgramData), 0, false); }
+
+    for (uint32_t slot = 0; slot < MAX_TOTAL_CUSTOM_PATTERN; ++slot) {
+      if (!(_customCharUsed & (1 << slot))) { continue; }
+      // only the 5 low bits of a pattern row are stored by the controller
+      bool isSame = isCgramRead;
+      for (uint32_t row = 0; row < CUSTOM_CHAR_PATTERN_LEN; ++row) {
+        isSame = isSame && (0 == ((cgramData[slot][row] ^ _customCharList[slot][row]) & 0x1f));
+      }
+      if (isSame) { continue; }
+
+      addrCounterChange(slot * LCD_MEMUSED_PER_x8_CHAR, false);
+      ramDataWrite(_customCharList[slot], CUSTOM_CHAR_PATTERN_LEN, false);
+    }
+  }
+}
+
+bool LcdDriver::calibrationStepRun(const uint32_t& timePercent) {
+  const uint8_t patternAddr =
+      LCD_DDRAM_LINE_LEN(_lcdConfig.geometry.isTwoLineMode) - LCD_CALIBRATION_LEN;
+  uint8_t pattern[LCD_CALIBRATION_LEN];
+  uint8_t readBack[LCD_CALIBRATION_LEN];
+  for (uint32_t pass = 0; pass < LCD_CALIBRATION_PASS; ++pass) {
+    // every data bit changes from one byte to the next and from one pass to the next
+    for (uint32_t index = 0; index < LCD_CALIBRATION_LEN; ++index) {
+      pattern[index] = (0x55 ^ (index * 0x1d)) ^ ((pass & 1) ? 0xff : 0);
+    }
+
+    // the timing has to work with every controller on the bus
+    for (uint32_t controller = 0; controller < _lcdConfig.totalController; ++controller) {
+      controllerSelect(BIT(controller));
+      timingSet(timePercent);
+      addrCounterChange(patternAddr, true);
+      parallelDataWrite(pattern, LCD_CALIBRATION_LEN, true);
+
+      timingSet(LCD_CALIBRATION_START_PERCENT);
+      ramDataRead(readBack, LCD_CALIBRATION_LEN, patternAddr, true);
+      if (0 != memcmp(pattern, readBack, LCD_CALIBRATION_LEN)) { return false; }
+    }
+  }
+  return true;
+}
+
+bool LcdDriver::timingCalibrate(void) {
+  LCD_INSTRUMENT_SCOPE(INSTRUMENT_TIMING_CALIBRATE);
+  if (_lcdConfig.isWriteOnly) { return false; }
+  // the steps have to go out synchronously
+  flush();
+  const bool     isAsyncActive = _isAsyncActive;
+  const uint32_t prevPercent   = _timingPercent;
+  _isAsyncActive               = false;
+
+  // start from a known state in case the current timing is already too short for this lcd
+  timingSet(LCD_CALIBRATION_START_PERCENT);
+  for (uint32_t controller = 0; controller < _lcdConfig.totalController; ++controller) {
+    controllerSelect(BIT(controller));
+    busyWait();
+  }
+  interfaceReset();
+
+  uint32_t passPercent = 0;
+  bool     isFailSeen  = false;
+  for (uint32_t timePercent = LCD_CALIBRATION_START_PERCENT;
+       timePercent >= LCD_CALIBRATION_MIN_PERCENT;
+       timePercent = timePercent * LCD_CALIBRATION_STEP_PERCENT / 100) {
+    if (!calibrationStepRun(timePercent)) {
+      isFailSeen = true;
+      break;
+    }
+    passPercent = timePercent;
+  }
+
+  // the failed step may have left anything executing or the nibbles out of step
+  for (uint32_t controller = 0; controller < _lcdConfig.totalController; ++controller) {
+    controllerSelect(BIT(controller));
+    _execTime           = 0;
+    _isBusyCheckPending = false;
+  }
+  _generalTimer.wait(LCD_CLEAR_EXEC_TIME_NANOSEC);
+  // every step down to LCD_CALIBRATION_MIN_PERCENT working only says the gpio calls outlast the
+  // timing of this lcd, not where its limit is, so stay on the datasheet
+  uint32_t newPercent = passPercent * (100 + LCD_CALIBRATION_MARGIN_PERCENT) / 100;
+  if (!isFailSeen && (newPercent < 100)) { newPercent = 100; }
+  timingSet((0 != passPercent) ? newPercent : prevPercent);
+  interfaceReset();
+
+  _isAsyncActive = isAsyncActive;
+  return 0 != passPercent;
+}
+
+/* EEPROM record */
+
+bool LcdDriver::recordLoad(void) {
+  LCD_INSTRUMENT_SCOPE(INSTRUMENT_RECORD_LOAD);
+  enableClockPeripheral(SYSCTL_PERIPH_EEPROM0);
+  if (EEPROM_INIT_OK != EEPROMInit()) { return false; }
+
+  LcdRecord        record;
+  LcdRecordContent content;
+  EEPROMRead((uint32_t*)&record, LCD_EEPROM_ADDR, sizeof(record));
+  if (!lcdRecordDecode(record, content)) { return false; }
+  if (content.timingPercent < LCD_CALIBRATION_MIN_PERCENT) { return false; }
+
+  timingSet(content.timingPercent);
+  _customCharUsed = content.customCharUsed;
+  memcpy(_customCharList, content.customCharList, sizeof(_customCharList));
+  _isRecordLoaded = true;
+  return true;
+}
+
+bool LcdDriver::recordSave(void) {
+  LCD_INSTRUMENT_SCOPE(INSTRUMENT_RECORD_SAVE);
+  enableClockPeripheral(SYSCTL_PERIPH_EEPROM0);
+  if (EEPROM_INIT_OK != EEPROMInit()) { return false; }
+
+  LcdRecordContent content;
+  content.timingPercent  = _timingPercent;
+  content.customCharUsed = _customCharUsed;
+  memcpy(content.customCharList, _customCharList, sizeof(_customCharList));
+  LcdRecord record;
+  lcdRecordEncode(content, record);
+
+  // the EEPROM wears out with every program so skip it if nothing changed
+  LcdRecord storedRecord;
+  EEPROMRead((uint32_t*)&storedRecord, LCD_EEPROM_ADDR, sizeof(storedRecord));
+  if (0 == memcmp(&record, &storedRecord, sizeof(record))) { return true; }
+  return 0 == EEPROMProgram((uint32_t*)&record, LCD_EEPROM_ADDR, sizeof(record));
 }
 
 /* Led Stuff */
 
 void LcdDriver::backLedSwitch(const bool& isBackLedOn) {
-  pinWrite(_lcdConfig.backLightPin, isBackLedOn);
+  LCD_INSTRUMENT_SCOPE(INSTRUMENT_BACK_LED_SWITCH);
+  pinWrite(_lcdConfig.backLightPin, isBackLedOn, TRACE_SIGNAL_BACK_LIGHT);
 }
 
 /* Content on LCD */
 void LcdDriver::displayWrite(const char* dataToWrite) {
+  LCD_INSTRUMENT_SCOPE(INSTRUMENT_DISPLAY_WRITE);
   assert(dataToWrite);
   assert(LCD_MAX_PRINT_STRING >= strlen(dataToWrite));
 
-  parallelDataWriteSingle(LCD_CLEAR_COMMAND, false);
-  ramDataWrite((uint8_t*)dataToWrite, strlen(dataToWrite), true);
+  uint8_t frame[LCD_MAX_TOTAL_ROW][LCD_MAX_TOTAL_COLUMN];
+  memset(frame, LCD_SPACE_CHAR, sizeof(frame));
+  uint8_t cursorX = 0;
+  uint8_t cursorY = 0;
+  textRender(frame, (uint8_t*)dataToWrite, strlen(dataToWrite), cursorX, cursorY);
+
+  frameFlush(frame);
+  _cursorX = cursorX;
+  _cursorY = cursorY;
+  addrCounterSync();
 }
 
 void LcdDriver::cursorPositionChange(const uint8_t& cursorX, const uint8_t& cursorY) {
-  assert(cursorX <= MAX_LCD_X && cursorY <= MAX_LCD_Y);
-  addrCounterChange(cursorY << 6 | cursorX, true);
+  LCD_INSTRUMENT_SCOPE(INSTRUMENT_CURSOR_POSITION_CHANGE);
+  assert(cursorX < _lcdConfig.geometry.totalColumn && cursorY < _lcdConfig.geometry.totalRow);
+  _cursorX = cursorX;
+  _cursorY = cursorY;
+  addrCounterSync();
 }
 
 void LcdDriver::displayAppend(const char* dataToAppend) {
-  // TODO: consider the effect of reading moving the cursor
+  LCD_INSTRUMENT_SCOPE(INSTRUMENT_DISPLAY_APPEND);
   assert(dataToAppend);
   assert(LCD_MAX_PRINT_STRING >= strlen(dataToAppend));
   ramDataWrite((uint8_t*)dataToAppend, strlen(dataToAppend), true);
@@ -176,19 +549,59 @@ void LcdDriver::displayAppend(const char* dataToAppend) {
 
 void LcdDriver::newCustomCharAdd(const uint8_t   charPattern[CUSTOM_CHAR_PATTERN_LEN],
                                  const uint32_t& customCharSlot) {
+  LCD_INSTRUMENT_SCOPE(INSTRUMENT_NEW_CUSTOM_CHAR_ADD);
   assert(customCharSlot < MAX_TOTAL_CUSTOM_PATTERN);
   assert(charPattern);
 
-  addrCounterChange(customCharSlot * LCD_MEMUSED_PER_x8_CHAR, false);
-  ramDataWrite(charPattern, CUSTOM_CHAR_PATTERN_LEN, false);
+  // every controller has its own CGRAM
+  for (uint32_t controller = 0; controller < _lcdConfig.totalController; ++controller) {
+    controllerSelect(BIT(controller));
+    addrCounterChange(customCharSlot * LCD_MEMUSED_PER_x8_CHAR, false);
+  }
+  controllerAllWrite(charPattern, CUSTOM_CHAR_PATTERN_LEN, true);
+  memcpy(_customCharList[customCharSlot], charPattern, CUSTOM_CHAR_PATTERN_LEN);
+  _customCharUsed |= 1 << customCharSlot;
 }
 
 void LcdDriver::lcdSettingSwitch(const bool& displayOn,
                                  const bool& cursorOn,
                                  const bool& cursorBlinkOn) {
-  parallelDataWriteSingle(displayCommandCreate(displayOn, cursorOn, cursorBlinkOn), false);
+  LCD_INSTRUMENT_SCOPE(INSTRUMENT_LCD_SETTING_SWITCH);
+  const uint8_t command = displayCommandCreate(displayOn, cursorOn, cursorBlinkOn);
+  controllerAllWrite(&command, 1, false);
 }
 
-void LcdDriver::lcdReset(void) { parallelDataWriteSingle(LCD_CLEAR_COMMAND, false); }
+void LcdDriver::lcdReset(void) {
+  LCD_INSTRUMENT_SCOPE(INSTRUMENT_LCD_RESET);
+  const uint8_t command = LCD_CLEAR_COMMAND;
+  controllerAllWrite(&command, 1, false);
+  shadowClear();
+}
+
+void LcdDriver::displaySelect(const uint32_t& displayMask) {
+  assert(_lcdConfig.isBroadcast);
+  assert((0 != displayMask) && (0 == (displayMask >> _lcdConfig.totalController)));
+  _displayMask = displayMask;
+}
+
+/* Async stuff */
+
+void LcdDriver::flush(void) {
+  LCD_INSTRUMENT_SCOPE(INSTRUMENT_FLUSH);
+  if (!_isAsyncActive) { return; }
+  txStart();
+  while (!isIdle()) { SysCtlDelay(LCD_TX_POLL_DELAY_LOOP); }
+}
+
+bool LcdDriver::isIdle(void) { return !_isAsyncActive || (_txEngine.isIdle() && !_isDmaBusy); }
+
+void LcdDriver::idleCallbackSet(LcdTxCallback callback, void* context) {
+  if (_lcdConfig.isDmaStreamed) {
+    _dmaIdleCallback        = callback;
+    _dmaIdleCallbackContext = context;
+  } else {
+    _txEngine.idleCallbackSet(callback, context);
+  }
+}
 
 }  // namespace lcddriver
\ No newline at end of file
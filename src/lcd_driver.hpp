@@ -12,6 +12,19 @@
 #include <cstdint>
 
 #include "general_timer/general_timer.hpp"
+#include "lcd_geometry.hpp"
+#include "lcd_include.hpp"
+#include "lcd_instrument.hpp"
+#include "lcd_record.hpp"
+#include "lcd_trace.hpp"
+#include "lcd_tx_engine.hpp"
+#include "lcd_waveform.hpp"
+
+/**
+ * @brief interrupt handler of LCD_TX_TIMER_INT, has to be put in the vector table when using
+ * LcdConfig::isAsync
+ */
+extern "C" void LcdTxTimerIntHandler(void);
 
 /**
  * @brief the namespace of the LcdDriver, all lcd controller related files are under this namespace
@@ -19,15 +32,15 @@
 namespace lcddriver {
 
 /**
- * @brief Max length of a string that can be printed onto LCD
+ * @brief Max length of a string that can be printed onto LCD, a full 40x4 with a newline per row
  */
-static const uint32_t LCD_MAX_PRINT_STRING = 32;
+static const uint32_t LCD_MAX_PRINT_STRING = LCD_MAX_TOTAL_ROW * (LCD_MAX_TOTAL_COLUMN + 1);
 
 /**
- * @brief Total pins used for sending/receiving data from the lcd driver(like D0-D7), the 1602 can
- * talk using either 4 or 8 pins
+ * @brief Max pins used for sending/receiving data from the lcd driver(like D0-D7), the 1602 can
+ * talk using either 4 or 8 pins, LcdConfig::is8BitBus picks which
  */
-static const uint32_t TOTAL_PARALLEL_PIN = 4;
+static const uint32_t TOTAL_PARALLEL_PIN = 8;
 
 /**
  * @brief how long is the array of array describing each pin, there are 3 members for describing:
@@ -60,6 +73,43 @@ static const uint32_t MAX_TOTAL_CUSTOM_PATTERN = 8;
  */
 static const uint32_t CUSTOM_CHAR_PATTERN_LEN = 8;
 
+static_assert((MAX_TOTAL_CUSTOM_PATTERN == LCD_RECORD_TOTAL_CHAR) &&
+                  (CUSTOM_CHAR_PATTERN_LEN == LCD_RECORD_CHAR_LEN),
+              "the EEPROM record has to hold every custom character");
+
+static_assert(LCD_MAX_CONTROLLER == TRACE_SIGNAL_EN3 - TRACE_SIGNAL_EN1 + 2,
+              "every controller needs an EN trace signal");
+
+/**
+ * @brief how the LcdDriver makes sure that the lcd controller is done with an instruction before
+ * sending the next one
+ */
+enum LcdPacingMode : uint32_t {
+  PACING_FIXED_DELAY = 0,  //!< wait out the datasheet execution time when the next one starts
+  PACING_BUSY_FLAG   = 1   //!< use datasheet bus timing then poll the busy flag b4 next instruction
+};
+
+/**
+ * @brief where enableAsync() and enableStep() are in the startup of the lcd
+ */
+enum LcdEnableState : uint32_t {
+  ENABLE_STATE_OFF     = 0,  //!< enableAsync() not called yet
+  ENABLE_STATE_STARTUP = 1,  //!< warming up and sending the startup commands
+  ENABLE_STATE_READY   = 2   //!< config written, the lcd can be used
+};
+
+/**
+ * @brief timing used by the LcdDriver for each bus transaction, all in nanosec, check
+ * lcd_include.hpp for what each of them means
+ */
+typedef struct {
+  uint32_t addrSetupTime;  //!< time that RS, R/W are stable b4 EN goes high
+  uint32_t dataSetupTime;  //!< time that data is stable b4 EN goes low
+  uint32_t dataHoldTime;   //!< time that data is stable after EN goes low
+  uint32_t pulseWidth;     //!< time that EN is high
+  uint32_t minCycleTime;   //!< time between two rising edge of EN
+} LcdTiming;
+
 /**
  * @brief the structure used for carrying the lcd controller settings
  * Each pin description is an array of 3 members describing:
@@ -67,26 +117,81 @@ static const uint32_t CUSTOM_CHAR_PATTERN_LEN = 8;
  * pin(like GPIO_PIN_6)
  */
 typedef struct {
-  bool     useBacklight;  //!< whether the backlight can be turned on/off using pin
+  bool          useBacklight;  //!< whether the backlight can be turned on/off using pin
+  LcdPacingMode pacingMode;    //!< how to wait for the controller between instructions
+  bool isAsync;  //!< queue writes and send them from the LCD_TX_TIMER_INT interrupt after enable()
+  bool isDmaStreamed;  //!< with isAsync, play the queue into the port with uDMA instead, RS, R/W,
+                       //!< EN and the data pins have to be on the same port, 4 bit bus only,
+                       //!< needs LCD_DMA_STREAM defined
+  bool is8BitBus;  //!< D0-D7 are wired, every byte takes one EN strobe instead of two
+  bool isWriteOnly;  //!< R/W is tied to ground and readWritePin is ignored, pacingMode is forced
+                     //!< to PACING_FIXED_DELAY and nothing is read back from the controller
+  LcdGeometry geometry;  //!< panel size and DDRAM address of its rows, like LCD_GEOMETRY_16X2
   uint32_t regSelectPin[PIN_DESCRIPTION_LEN];  //!< arrays describing the RS(register selector) pin
   uint32_t readWritePin[PIN_DESCRIPTION_LEN];  //!< arrays for descirbing the RS(Read/Write pin)
-  uint32_t enablePin[PIN_DESCRIPTION_LEN];     //!< arrays for describing the enable pin
+  uint32_t totalController;  //!< controllers sharing RS, R/W and the data pins, 2 for a 40x4, more
+                             //!< than one can't be used with isAsync
+  uint32_t enablePinList[LCD_MAX_CONTROLLER][PIN_DESCRIPTION_LEN];  //!< EN of each controller
+  bool isBroadcast;  //!< each EN drives a display of its own that shows the whole geometry, text
+                     //!< goes to the ones picked by displaySelect() with their EN strobed together
   uint32_t backLightPin[PIN_DESCRIPTION_LEN];  //!< arrays for controlling the backlight pin, if you
                                                //!< don't have one just don't set it
 
   /**
-   * @brief multidimensional array containing the description for pin D4-D7(if using 4 pins) or
-   * D0-D7(if using 8 pins)
+   * @brief multidimensional array containing the description for pin D4-D7 in the first 4(if using
+   * 4 pins) or D0-D7(if using 8 pins)
    */
   uint32_t parallelPinList[TOTAL_PARALLEL_PIN][PIN_DESCRIPTION_LEN];
 } LcdConfig;
 
+/**
+ * @brief what the LcdDriver tracks of a controller while another one is selected
+ */
+typedef struct {
+  bool     isBusyCheckPending;
+  uint64_t execStartStamp;
+  uint32_t execTime;
+  uint8_t  addrCounter;
+  bool     isAddrCounterKnown;
+} LcdControllerState;
+
+/**
+ * @brief the EN pins of the selected controllers that are on the same gpio port, they rise and fall
+ * with a single port write
+ */
+typedef struct {
+  uint32_t portBase;  //!< the gpio port(like GPIO_PORTE_BASE)
+  uint8_t  pinMask;   //!< all selected EN pins on this port
+} LcdEnablePort;
+
+/**
+ * @brief a run of characters of a frame that differ from the DDRAM shadow, see frameFlush
+ */
+typedef struct {
+  uint8_t row;      //!< LcdGeometry::totalRow once the frame has no span left
+  uint8_t column;   //!< next character to send
+  uint8_t spanEnd;  //!< column right after the span
+} LcdFrameSpan;
+
+/**
+ * @brief the data pins(like D4-D7) that are on the same gpio port, used to write a whole nibble or
+ * byte to a port in one go instead of pin by pin
+ */
+typedef struct {
+  uint32_t portBase;  //!< the gpio port(like GPIO_PORTB_BASE)
+  uint8_t  pinMask;   //!< all data pins on this port
+  uint8_t  nibbleOutput[16];     //!< what to write to the port for each value of D4-D7
+  uint8_t  lowNibbleOutput[16];  //!< same for D0-D3, all 0 with a 4 bit bus
+} LcdDataPort;
+
 /**
  * @brief The main class for the LcdDriver, all interactions with the 1602 lcd controller will be
  * through this class
  *
  */
-class LcdDriver {
+class LcdDriver : private LcdTxBus {
+  friend void ::LcdTxTimerIntHandler(void);
+
  private:
   /**
    * @brief How many bits that each pin has to send, if using 8 then each only has to send 1, but if
@@ -94,16 +199,231 @@ class LcdDriver {
    */
   uint32_t _totalBitPerPin;
 
+  /**
+   * @brief data pins in use, 4 or 8 depending on LcdConfig::is8BitBus
+   */
+  uint32_t _totalParallelPin;
+
   /**
    * @brief The LcdDriver copy of the user config received at constructor
    */
   LcdConfig _lcdConfig;
 
+  /**
+   * @brief data pins grouped by port, computed from the config at constructor
+   */
+  LcdDataPort _dataPortList[TOTAL_PARALLEL_PIN];
+
+  /**
+   * @brief how many different ports the data pins are spread over
+   */
+  uint32_t _totalDataPort;
+
+  /**
+   * @brief current direction of the data pins, parallelModeSwitch only touches the hardware when
+   * it changes
+   */
+  bool _isParallelInput;
+
+  /**
+   * @brief last level written to RS, with LcdConfig::isWriteOnly nothing else needs the address
+   * setup time so comSetup skips both while RS stays the same
+   */
+  bool _isRegSelectData;
+  bool _isRegSelectKnown;  //!< false until RS is written once
+
   /**
    * @brief Instance of general timer used for all timing purposes
    */
   GeneralTimer _generalTimer;
 
+  /**
+   * @brief bus timing currently used for all transactions
+   */
+  LcdTiming _timing;
+
+  /**
+   * @brief what _timing is in percent of the datasheet timing
+   */
+  uint32_t _timingPercent;
+
+  /**
+   * @brief controllers whose EN is strobed, a bit per index of LcdConfig::enablePinList, more than
+   * one only for a broadcast, the pacing and address counter members below are the ones of this
+   * group, the others wait in _controllerStateList until controllerSelect()
+   */
+  uint32_t           _enableMask;
+  LcdControllerState _controllerStateList[LCD_MAX_CONTROLLER];
+
+  /**
+   * @brief the EN pins of _enableMask grouped by port
+   */
+  LcdEnablePort _enablePortList[LCD_MAX_CONTROLLER];
+  uint32_t      _totalEnablePort;
+
+  /**
+   * @brief displays picked by displaySelect(), only used with LcdConfig::isBroadcast
+   */
+  uint32_t _displayMask;
+
+  /**
+   * @brief true if the last instruction may still be executing and the busy flag has to be polled
+   * b4 the next one, only used with PACING_BUSY_FLAG
+   */
+  bool _isBusyCheckPending;
+
+  /**
+   * @brief general timer stamp of when the last instruction was sent and how long the controller
+   * takes to execute it, the wait happens when the next transaction starts so whatever the
+   * application does in between hides it, _execTime is 0 if nothing is pending, only used with
+   * PACING_FIXED_DELAY
+   */
+  uint64_t _execStartStamp;
+  uint32_t _execTime;
+
+  /**
+   * @brief copy of what is currently in the visible part of the DDRAM of each controller, used to
+   * only send the characters that changed, a controller only uses the rows that it shows
+   */
+  uint8_t _ddramShadow[LCD_MAX_CONTROLLER][LCD_MAX_TOTAL_ROW][LCD_MAX_TOTAL_COLUMN];
+
+  /**
+   * @brief x coordinate of where the next character will be printed, equal to the row width once
+   * the row is full, the next character then goes to the start of the next row
+   */
+  uint8_t _cursorX;
+
+  /**
+   * @brief y coordinate of where the next character will be printed
+   */
+  uint8_t _cursorY;
+
+  /**
+   * @brief copy of the lcd controller DDRAM address counter, only valid if _isAddrCounterKnown
+   */
+  uint8_t _addrCounter;
+
+  /**
+   * @brief false if the address counter may be pointing somewhere unknown(like CGRAM after adding
+   * custom character)
+   */
+  bool _isAddrCounterKnown;
+
+  /**
+   * @brief copy of every custom character added, kept for the EEPROM record
+   */
+  uint8_t  _customCharList[MAX_TOTAL_CUSTOM_PATTERN][CUSTOM_CHAR_PATTERN_LEN];
+  uint32_t _customCharUsed;  //!< bit per slot of _customCharList that has a pattern
+
+  /**
+   * @brief true once recordLoad() found a record, enable() then restores the custom characters
+   */
+  bool _isRecordLoaded;
+
+  /**
+   * @brief startup progress of enableAsync(), the startup commands sent so far and when the last
+   * step started
+   */
+  LcdEnableState _enableState;
+  uint32_t       _enableStartupSent;
+  uint64_t       _enableStepStamp;
+  uint32_t       _enableStepTime;  //!< nanosec to wait after the last step b4 the next one
+
+  /**
+   * @brief sends the queued bytes when LcdConfig::isAsync is set
+   */
+  LcdTxEngine _txEngine;
+
+  /**
+   * @brief true once enable() is done with LcdConfig::isAsync set, writes are queued from then on
+   */
+  bool _isAsyncActive;
+
+  /**
+   * @brief LCD_TX_TIMER_BASE ticks per microsec
+   */
+  uint32_t _txTickPerMicrosec;
+
+  /**
+   * @brief records the queue into the uDMA buffer when LcdConfig::isDmaStreamed is set
+   */
+  LcdWaveform _waveform;
+
+  /**
+   * @brief true while the uDMA is playing a recorded waveform
+   */
+  volatile bool _isDmaBusy;
+
+  /**
+   * @brief called when the uDMA is done with the queue, the LcdTxEngine calls the user directly
+   * when it's not streamed
+   */
+  LcdTxCallback _dmaIdleCallback;
+  void *        _dmaIdleCallbackContext;
+
+  /**
+   * @brief set the bus timing of the synchronous transactions and of the LcdTxEngine to a
+   * percentage of the datasheet values, the uDMA stream always uses the datasheet timing
+   * @param timePercent how much of the datasheet timing to use, 100 means use them as is
+   */
+  void timingSet(const uint32_t &timePercent);
+
+  /**
+   * @brief put the controller back in the bus width of the config from any state with the startup
+   * sequence of the datasheet, then write the config and clear the display like enable()
+   */
+  void interfaceReset(void);
+
+  /**
+   * @brief strobe LCD_STARTUP_COMMAND into every controller, one after the other so they take the
+   * same wait
+   */
+  void startupCommandWrite(void);
+
+  /**
+   * @brief read the whole CGRAM in one go and only upload the custom characters of _customCharList
+   * that it doesn't hold already, it survives a reset of the TivaC while the lcd keeps its power
+   * With LcdConfig::isWriteOnly the CGRAM can't be read so every used slot is uploaded
+   */
+  void customCharRestore(void);
+
+  /**
+   * @brief write the test pattern with a timing then read it back with the
+   * LCD_CALIBRATION_START_PERCENT one
+   * @param timePercent the timing to test in percent of the datasheet
+   * @return true if every pass read back what was written
+   */
+  bool calibrationStepRun(const uint32_t &timePercent);
+
+  /**
+   * @brief wait until the lcd controller is done with the last instruction, either by polling the
+   * busy flag or by waiting for what's left of its execution time
+   * Does nothing if there is no pending instruction, the controllers of a broadcast are polled one
+   * by one since only one of them can drive the data pins
+   */
+  void busyWait(void);
+
+  /**
+   * @brief poll the busy flag of the selected controller until it's clear, gives up after
+   * LCD_BUSY_POLL_TIMEOUT_NANOSEC
+   */
+  void busyPoll(void);
+
+  /**
+   * @brief mark a byte that was just sent as executing, how it's waited for depends on the pacing
+   * mode
+   * @param data the byte sent
+   * @param isDataReg true if it went to the RAM, false if it's an instruction
+   */
+  void execPendingSet(const uint8_t &data, const bool &isDataReg);
+
+  /**
+   * @brief datasheet time that the lcd controller takes to execute a byte
+   * @param data the byte sent
+   * @param isDataReg true if it went to the RAM, false if it's an instruction
+   */
+  static uint32_t execTimeGet(const uint8_t &data, const bool &isDataReg);
+
   /**
    * @brief used for reading the data from the controller RAM/program memory
    * The method will follow procedures outlined in the datasheet to intiate and read data from the
@@ -135,9 +455,87 @@ class LcdDriver {
    */
   void parallelDataWriteSingle(const uint8_t &data, const bool &isDataReg);
 
+  /**
+   * @brief put a byte on the data pins with EN already high, one strobe per nibble, and end the
+   * transaction with comStop()
+   * @param data the byte to be written
+   */
+  void byteStrobe(const uint8_t &data);
+
+  /**
+   * @brief turn on LCD_TX_TIMER_BASE as a one shot timer with its interrupt, only one LcdDriver can
+   * be asynchronous
+   */
+  void txTimerInit(void);
+
+  /**
+   * @brief stop the LCD_TX_TIMER_INT interrupt and let another LcdDriver use the timer
+   */
+  void txTimerDeinit(void);
+
+  /**
+   * @brief fire the LCD_TX_TIMER_INT interrupt after a delay
+   * @param delay nanosec to wait
+   */
+  void txTimerArm(const uint32_t &delay);
+
+  /**
+   * @brief start sending the queue from the interrupt if it's not already being sent
+   */
+  void txStart(void);
+
+  /**
+   * @brief queue bytes for the interrupt to send, waits for room if the queue is full
+   * @param dataList array of data to be sent
+   * @param dataLen how many byte to send
+   * @param isDataReg is the destination data memory(like RAM) or lcd controller memory
+   */
+  void txQueuePush(const uint8_t *dataList, const uint32_t &dataLen, const bool &isDataReg);
+
+  /**
+   * @brief body of LcdTxTimerIntHandler, runs the LcdTxEngine until the next delay is long enough
+   * to be worth rearming the timer, or starts the next uDMA stream
+   */
+  void txTimerIsr(void);
+
+  /**
+   * @brief check that the pins can be streamed, then set up the uDMA channel and the waveform
+   */
+  void dmaInit(void);
+
+  /**
+   * @brief record what's queued into the waveform buffer and start playing it, or go idle if the
+   * queue is empty
+   */
+  void dmaStart(void);
+
+  void txRegisterSelect(const bool &isDataReg) override;
+  void txDataPut(const uint8_t &value) override;
+  void txEnableSwitch(const bool &output) override;
+
+  /**
+   * @brief group the data pins by port and compute the port value for every nibble
+   */
+  void dataPortCreate(void);
+
+  /**
+   * @brief put what one strobe carries on the data pins, a nibble on D4-D7 or a byte on D0-D7, one
+   * port write per port used by the data pins
+   * @param value the value to output, only the low 4 bits are used with a 4 bit bus
+   */
+  void dataPinWrite(const uint8_t &value);
+
+  /**
+   * @brief read what one strobe carries from the data pins, one port read per port used by the
+   * data pins
+   * @return uint8_t the nibble in the low 4 bits with a 4 bit bus, the byte otherwise
+   */
+  uint8_t dataPinRead(void);
+
   /**
    * @brief switch all the data pins(like D0-D7) to input mode or output mode
-   * Used for quickly switching between receiving and sending data
+   * Used for quickly switching between receiving and sending data, does nothing if the pins are
+   * already in that mode, otherwise only the direction register of each data port is written
    * @param isInput if true then all data pin becomes input else become output
    */
   void parallelModeSwitch(const bool &isInput);
@@ -155,8 +553,11 @@ class LcdDriver {
    * communcication
    * @param pinDesc array describing the pin
    * @param output if true, set pin to high, otherwise, set to low
+   * @param traceSignal what the pin is in the LCD_TRACE buffer
    */
-  void pinWrite(const uint32_t pinDesc[PIN_DESCRIPTION_LEN], const bool &output);
+  void pinWrite(const uint32_t       pinDesc[PIN_DESCRIPTION_LEN],
+                const bool &          output,
+                const LcdTraceSignal &traceSignal);
 
   /**
    * @brief Read whehther a pin is high or low
@@ -179,6 +580,49 @@ class LcdDriver {
    */
   void pinDescCheck(uint32_t pinDesc[PIN_DESCRIPTION_LEN]);
 
+  /**
+   * @brief check that LcdConfig::geometry fits the DDRAM, will raise assert if not
+   */
+  void geometryCheck(void);
+
+  /**
+   * @brief make a group of controllers the one that the next transactions go to, its pacing and
+   * address counter are swapped in with the ones of the previous group, a group waits for the
+   * slowest of its controllers and only knows its address counter if they all agree
+   * @param enableMask a bit per index of LcdConfig::enablePinList
+   */
+  void controllerSelect(const uint32_t &enableMask);
+
+  /**
+   * @brief group the EN pins of _enableMask by port
+   */
+  void enablePortCreate(void);
+
+  /**
+   * @brief get the controllers that a controller of LcdConfig::geometry stands for
+   * @param controller index used by LcdGeometry::rowControllerList
+   * @return a bit for the controller itself, or for every display picked by displaySelect() with
+   * LcdConfig::isBroadcast
+   */
+  uint32_t panelMaskGet(const uint32_t &controller);
+
+  /**
+   * @brief how much of an execution time is left
+   * @param execStartStamp general timer stamp of when the instruction was sent
+   * @param execTime how long the instruction takes
+   * @return nanosec left, 0 if it's over or nothing is pending
+   */
+  uint32_t execLeftGet(const uint64_t &execStartStamp, const uint32_t &execTime);
+
+  /**
+   * @brief write the same bytes to every controller, each byte goes to all of them b4 the next one
+   * so they execute it at the same time, the identical displays of a broadcast are strobed together
+   * @param dataList the bytes
+   * @param dataLen how many bytes
+   * @param isDataReg true if the bytes are data, false if instructions
+   */
+  void controllerAllWrite(const uint8_t *dataList, const uint32_t &dataLen, const bool &isDataReg);
+
   /**
    * @brief Utility function used to generate signal to start the communication with the lcd
    * controller
@@ -203,6 +647,12 @@ class LcdDriver {
    */
   void comMaintain(const bool &isReadMode);
 
+  /**
+   * @brief assert the enable line again after comStop() to write the next byte of a transaction,
+   * RS and RW are still set up from comSetup()
+   */
+  void comResume(void);
+
   /**
    * @brief select data(like RAM) or program register be switching the RS line
    * @param isDataReg if true then the RS line is pulled high to indicate that transaction will
@@ -217,7 +667,7 @@ class LcdDriver {
   void configWrite(void);
 
   /**
-   * @brief turn on or off communication by switching the EN pin
+   * @brief turn on or off communication by switching the EN pins of the selected controllers
    * @param iscomEnabled true then EN pin pulled high, pulled low otherwise
    */
   void comSwitch(const bool &iscomEnabled);
@@ -274,14 +724,16 @@ class LcdDriver {
   uint8_t cursorDisplayShiftCommandCreate(const bool &isShiftDisplay, const bool &isRight);
 
   /**
-   * @brief Read lcd controller memory and see if the lcd is busy with an operation
+   * @brief Read lcd controller memory and see if the lcd is busy with an operation, with
+   * LcdConfig::isWriteOnly it tells whether the execution time of the last write is not over yet
    * @return true lcd is doing an operation
    * @return false lcd is idle
    */
   bool lcdIsBusy(void);
   /**
    * @brief Read lcd controller memory to retrieve the 7 bits address counter
-   * This command can be helpful during debug to probe what memories are being read
+   * This command can be helpful during debug to probe what memories are being read, with
+   * LcdConfig::isWriteOnly the address that the driver tracks is returned instead
    * @return uint8_t the 7 bits address counter
    */
   uint8_t addrCounterGet(void);
@@ -297,14 +749,14 @@ class LcdDriver {
   void addrCounterChange(const uint8_t &addr, const bool &isDataRam);
 
   /**
-   * @brief Used to write only 4 bits using D4-D7
-   * This command is used mainly during the beginning of the communication where all data is sent
-   * using 4 pins only once instead of 4 pins twice like the rest of the communication
+   * @brief Used to write an instruction with a single strobe, only its high 4 bits with a 4 bit bus
+   * This command is used mainly during the beginning of the communication where the controller is
+   * still in 8 bit mode and takes every strobe as a whole instruction
    * @param dataToWrite data to be written, most likely a command to setup communication
    * @param stopAfterWrite if true terminate connection after write, otherwise maintain the
    * connection with the lcd controller
    */
-  void dataWrite4Bit(const uint32_t &dataToWrite, const bool &stopAfterWrite);
+  void singleStrobeWrite(const uint32_t &dataToWrite, const bool &stopAfterWrite);
 
   /**
    * @brief Read the lcd controller data to get the busy status and current address counter
@@ -319,9 +771,88 @@ class LcdDriver {
    * @param dataLen len of the array of data
    * @param isTextMode true if in text mode, text mode is helpful for writing to data RAM to be
    * displayed, text mode will interpret special character like \n or $
+   * Characters between newlines are sent as one run so RS/RW setup is only done once per run with
+   * PACING_FIXED_DELAY, PACING_BUSY_FLAG still sets them up for every character since the flag is
+   * read in between, a run that fills its row carries on at the start of the next one and text past
+   * the last row is dropped
    */
   void ramDataWrite(const uint8_t *data, const uint32_t dataLen, const bool &isTextMode);
 
+  /**
+   * @brief fill the DDRAM shadow with spaces and put the cursor back at (0,0), used after sending a
+   * clear command
+   */
+  void shadowClear(void);
+
+  /**
+   * @brief copy characters that were just sent into the shadow of every selected controller
+   * @param row row of the first character
+   * @param column column of the first character
+   * @param data the characters
+   * @param dataLen how many, they have to stay on the row
+   */
+  void shadowWrite(const uint8_t & row,
+                   const uint8_t & column,
+                   const uint8_t * data,
+                   const uint32_t &dataLen);
+
+  /**
+   * @brief check whether a character has to be sent
+   * @param shadowMask the controllers it would go to
+   * @param row row of the character
+   * @param column column of the character
+   * @param value the character
+   * @return true if the shadow of any of the controllers has something else there
+   */
+  bool shadowIsStale(const uint32_t &shadowMask,
+                     const uint8_t & row,
+                     const uint8_t & column,
+                     const uint8_t & value);
+
+  /**
+   * @brief render a string in text mode onto a frame, same format as displayWrite
+   * Rows wrap like ramDataWrite does and characters past the last row are dropped
+   * @param frame the frame to render onto
+   * @param data the string to render
+   * @param dataLen len of the string
+   * @param cursorX x coordinate to start at, updated to where the text ends
+   * @param cursorY y coordinate to start at, updated to where the text ends
+   */
+  void textRender(uint8_t        frame[LCD_MAX_TOTAL_ROW][LCD_MAX_TOTAL_COLUMN],
+                  const uint8_t *data,
+                  const uint32_t dataLen,
+                  uint8_t &      cursorX,
+                  uint8_t &      cursorY);
+
+  /**
+   * @brief send a frame to the lcd, only the spans that are different from the DDRAM shadow are
+   * sent, each with one address change and one burst write
+   * With more than one controller they take turns a byte at a time, so each one executes its byte
+   * while the others are written, the displays of a broadcast get a character if any of them shows
+   * something else
+   * @param frame the new content of the display
+   */
+  void frameFlush(const uint8_t frame[LCD_MAX_TOTAL_ROW][LCD_MAX_TOTAL_COLUMN]);
+
+  /**
+   * @brief find the next span of a frame on the rows of a controller, a span ends once there are 2
+   * unchanged characters in a row since rewriting one costs the same as a new address change
+   * @param frame the new content of the display
+   * @param controller the controller whose rows are searched
+   * @param span where to start searching, set to the span found
+   * @return false if there's no span left, span.row is then LcdGeometry::totalRow
+   */
+  bool frameSpanFind(const uint8_t   frame[LCD_MAX_TOTAL_ROW][LCD_MAX_TOTAL_COLUMN],
+                     const uint32_t &controller,
+                     LcdFrameSpan &  span);
+
+  /**
+   * @brief select the controller of the cursor row and move its address counter to the cursor if
+   * it's not there already, a cursor past the end of its row is left alone since the next
+   * character moves it anyway
+   */
+  void addrCounterSync(void);
+
   /**
    * @brief Used for reading the RAM of the lcd controller, it can either be the data ram storing
    * data to be displayed or the character generator ram, storing custom pattern
@@ -347,6 +878,11 @@ class LcdDriver {
    */
   LcdDriver(const LcdConfig &lcdConfig);
 
+  /**
+   * @brief Destroy the Lcd Driver object, gives back the timer used when asynchronous
+   */
+  ~LcdDriver();
+
   /**
    * @brief Initialize the lcd driver, by turning on all gpio clocks and set the gpio mode to be
    * ready to drive the lcd
@@ -357,30 +893,63 @@ class LcdDriver {
    * @brief Start communicating with the lcd and write settings to the lcd controller, this might
    * take more than other operations since it will wait the recommended amount of time in the manual
    * for the lcd to warm up
+   * It's enableAsync() then enableStep() until the lcd is ready with the waits in between
    */
   void enable(void);
 
+  /**
+   * @brief Same as enable() without blocking, only starts the warm up, enableStep() has to be
+   * called until it returns true, no other method than enableStep() and enableWaitTimeGet() can be
+   * used in the meantime
+   */
+  void enableAsync(void);
+
+  /**
+   * @brief Move the startup along if the wait of the current step is over, call it from the main
+   * loop, a step only takes a few microsec except the last one that writes the config and spins
+   * through the clear display(about 1.7 ms at the datasheet timing)
+   * It must not be called from a GeneralTimer timeout or any other interrupt: timeouts run in the
+   * WTIMER0 interrupt that would be held for the whole last step, and waits inside an interrupt
+   * always spin even with sleepWaitSet(). A timeout set to enableWaitTimeGet() may only flag that
+   * the main loop has to call it
+   * @return true once the lcd is ready
+   */
+  bool enableStep(void);
+
+  /**
+   * @brief get how long until enableStep() has something to do
+   * @return uint32_t nanosec, 0 if the next step is due or the lcd is ready
+   */
+  uint32_t enableWaitTimeGet(void);
+
+  /**
+   * @brief check if the startup is done
+   * @return true after enable() or once enableStep() returned true
+   */
+  bool isEnabled(void) { return ENABLE_STATE_READY == _enableState; }
+
   /**
    * @brief Erase the display and add new text to it starting at position (0,0), this method will be
    * the one used the most as it offers the most straightforward interface to writing to the LCD
-   * @param dataToWrite character array reprenting string to print, limited at 32
+   * Only the characters that differ from what is already on the display are sent so calling this
+   * repeatedly with mostly the same text is cheap
+   * @param dataToWrite character array reprenting string to print, limited at LCD_MAX_PRINT_STRING
    */
   void displayWrite(const char *dataToWrite);
 
   /**
    * @brief Append text to existing text onscreen, this method will also be used the most if there
    * is no need to modify the deeper level API
-   * Note that during other operation, the cursor might
-   * have been moved, if that happens, it's best to use the cursorPositionChange to get back to the
-   * desired position and continue printing text
-   * @param dataToAppend character array reprenting string to print, limited at 32
+   * The text continues where the last displayWrite/displayAppend stopped, use cursorPositionChange
+   * to continue printing text somewhere else
+   * @param dataToAppend character array reprenting string to print, limited at LCD_MAX_PRINT_STRING
    */
   void displayAppend(const char *dataToAppend);
 
   /**
    * @brief Add new custom character pattern
    * The new pattern will be stored in the custom generator RAM of the lcd controller, the 1602 can
-   * store 8 5x8 or 4 5x10 pattern
+   * store 8 5x8 or 4 5x10 pattern, a copy is kept for recordSave()
    * @param charPattern array storing the byte patterns, generate them using the link in the README
    * @param customCharSlot what slot to store the new pattern at, there should be 8 slot if 5x8 font
    * is used
@@ -390,7 +959,8 @@ class LcdDriver {
 
   /**
    * @brief Change lcd settings like on/off display, cursor, or blinking mode
-   *  This method writes to the lcd controller register to set the settings
+   *  This method writes to the lcd controller register to set the settings, every controller gets
+   *  the same settings so with a 40x4 the cursor shows on both halves
    * @param displayOn display on if true, off otherwise
    * @param cursorOn cursor on if true, off otherwise
    * @param cursorBlinkOn cursor blinking on if true, off otherwise
@@ -401,12 +971,23 @@ class LcdDriver {
    * @brief reset the LCD and erase all RAM, also reset cursor to (0,0)
    */
   void lcdReset(void);
+
+  /**
+   * @brief pick the displays that displayWrite(), displayAppend() and cursorPositionChange() go to,
+   * only with LcdConfig::isBroadcast, every display is picked until then
+   * The picked displays are written at once with their EN strobed together, each one keeps its own
+   * shadow so a character is sent if any of them shows something else, displays given different
+   * text catch up in the same pass, they share the cursor
+   * Settings, custom characters and lcdReset() always go to every display
+   * @param displayMask a bit per index of LcdConfig::enablePinList
+   */
+  void displaySelect(const uint32_t &displayMask);
   /**
    * @brief Change cursor position on an x-y scale
    * This method also changes the data ram position with the cursor so future texts will be printed
    * at the cursor
-   * @param cursorX x coordinate to set, max at 15 for 16x2 lcd
-   * @param cursorY y coordinate to set, max at 1 for 16x2 lcd
+   * @param cursorX x coordinate to set, below LcdGeometry::totalColumn
+   * @param cursorY y coordinate to set, below LcdGeometry::totalRow
    */
   void cursorPositionChange(const uint8_t &cursorX, const uint8_t &cursorY);
 
@@ -418,6 +999,66 @@ class LcdDriver {
    * @param isBackLedOn turn on LED if true, off otherwise
    */
   void backLedSwitch(const bool &isBackLedOn);
+
+  /**
+   * @brief find the shortest bus timing that this lcd and its wiring handle, the timing is
+   * shortened step by step from LCD_CALIBRATION_START_PERCENT of the datasheet while a pattern
+   * written to the last LCD_CALIBRATION_LEN bytes of the first DDRAM line reads back right, then
+   * LCD_CALIBRATION_MARGIN_PERCENT is added to the shortest one that worked and it is used from
+   * then on, if not even LCD_CALIBRATION_MIN_PERCENT failed the datasheet timing is kept as the
+   * lowest
+   * Those bytes are only off screen on the 8x1, 16x1 and 16x2 presets, the 20x2 and 40x2 show part
+   * of the pattern on row 0, the 16x4 on row 2, the 20x4 on row 0 and 2 and the 40x4 on row 0 and
+   * 2 since both controllers get it, it stays there until the display is cleared at the end
+   * Call it right after enable(), the steps that fail may send garbage instructions so the
+   * controller is reset at the end like enable() does, the display is cleared and the custom
+   * characters may be lost, it takes a few tens of millisec
+   * With LcdConfig::isWriteOnly the pattern can't be read back, nothing is sent and false returned
+   * @return true if a timing was found, false if even the first one failed and the timing is kept
+   */
+  bool timingCalibrate(void);
+
+  /**
+   * @brief get the bus timing in use
+   * @return uint32_t percent of the datasheet timing
+   */
+  uint32_t timingPercentGet(void) { return _timingPercent; }
+
+  /**
+   * @brief load the bus timing and the custom characters saved by recordSave() from the EEPROM,
+   * call it b4 enable()
+   * enable() then uploads only the custom characters that the CGRAM lost and, unless the TivaC
+   * reset cause is a power on or brown out, skips the warm up wait since the lcd kept its power,
+   * the causes are sticky so the application has to clear them with SysCtlResetCauseClear()
+   * @return true if a valid record was found, false if it's missing, corrupt or of an older version
+   */
+  bool recordLoad(void);
+
+  /**
+   * @brief save the bus timing and the custom characters added so far to the EEPROM, the EEPROM is
+   * only programmed if the record changed
+   * @return true if the record is stored
+   */
+  bool recordSave(void);
+
+  /**
+   * @brief wait until everything queued in async mode has been sent and executed by the lcd
+   * controller, returns right away if not in async mode
+   */
+  void flush(void);
+
+  /**
+   * @brief check whether everything queued in async mode has been sent and executed
+   * @return true if nothing is left, always true if not in async mode
+   */
+  bool isIdle(void);
+
+  /**
+   * @brief set a function to be called from the interrupt each time the async queue is done
+   * @param callback the function, nullptr to remove it
+   * @param context passed to the callback as is
+   */
+  void idleCallbackSet(LcdTxCallback callback, void *context);
 };
 }  // namespace lcddriver
 #endif
\ No newline at end of file
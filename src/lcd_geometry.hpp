@@ -0,0 +1,91 @@
+/**
+ * @brief size of the panel driven by the HD44780 and where each of its rows sits in the DDRAM, the
+ * controller only knows about 1 or 2 lines of DDRAM so a 4 row panel shows each line on 2 rows or
+ * has a second controller for the bottom 2 rows
+ *
+ * @file lcd_geometry.hpp
+ * @author Khoi Trinh
+ * @date 2018-09-23
+ */
+
+#ifndef _LCD_GEOMETRY_HPP
+#define _LCD_GEOMETRY_HPP
+
+#include <cstdint>
+
+namespace lcddriver {
+
+/**
+ * @brief most rows a panel can have
+ */
+static const uint32_t LCD_MAX_TOTAL_ROW = 4;
+
+/**
+ * @brief most characters a row can have, a 40x2 uses the whole DDRAM
+ */
+static const uint32_t LCD_MAX_TOTAL_COLUMN = 40;
+
+/**
+ * @brief most controllers that can share the bus, each has its own EN
+ */
+static const uint32_t LCD_MAX_CONTROLLER = 4;
+
+/**
+ * @brief the geometry given to LcdConfig, use one of the LCD_GEOMETRY_ presets below
+ */
+typedef struct {
+  uint8_t totalColumn;    //!< characters shown on a row
+  uint8_t totalRow;       //!< rows of the panel
+  bool    isTwoLineMode;  //!< N bit of the function set, DDRAM is split in 2 lines of 40 if true
+  uint8_t rowAddrList[LCD_MAX_TOTAL_ROW];  //!< DDRAM address of the first character of each row
+  uint8_t rowControllerList[LCD_MAX_TOTAL_ROW];  //!< controller of each row, all 0 with just one
+} LcdGeometry;
+
+/**
+ * @brief 8x1, one line of DDRAM
+ */
+static constexpr LcdGeometry LCD_GEOMETRY_8X1 = {8, 1, false, {0x00}, {0}};
+
+/**
+ * @brief 16x1 with a single 16 character line, modules that split it in two 8 character halves
+ * at 0x00 and 0x40 have to be driven as a 8x2 with the rows side by side
+ */
+static constexpr LcdGeometry LCD_GEOMETRY_16X1 = {16, 1, false, {0x00}, {0}};
+
+/**
+ * @brief 16x2, the 1602
+ */
+static constexpr LcdGeometry LCD_GEOMETRY_16X2 = {16, 2, true, {0x00, 0x40}, {0, 0}};
+
+/**
+ * @brief 16x4, row 2 and 3 carry on the first and second DDRAM line
+ */
+static constexpr LcdGeometry LCD_GEOMETRY_16X4 = {
+    16, 4, true, {0x00, 0x40, 0x10, 0x50}, {0, 0, 0, 0}};
+
+/**
+ * @brief 20x2
+ */
+static constexpr LcdGeometry LCD_GEOMETRY_20X2 = {20, 2, true, {0x00, 0x40}, {0, 0}};
+
+/**
+ * @brief 20x4, row 2 and 3 carry on the first and second DDRAM line
+ */
+static constexpr LcdGeometry LCD_GEOMETRY_20X4 = {
+    20, 4, true, {0x00, 0x40, 0x14, 0x54}, {0, 0, 0, 0}};
+
+/**
+ * @brief 40x2
+ */
+static constexpr LcdGeometry LCD_GEOMETRY_40X2 = {40, 2, true, {0x00, 0x40}, {0, 0}};
+
+/**
+ * @brief 40x4, two 40x2 controllers with LcdConfig::totalController at 2, the second one shows row
+ * 2 and 3
+ */
+static constexpr LcdGeometry LCD_GEOMETRY_40X4 = {
+    40, 4, true, {0x00, 0x40, 0x00, 0x40}, {0, 0, 1, 1}};
+
+}  // namespace lcddriver
+
+#endif
@@ -10,54 +10,97 @@
 #ifndef _LCD_INCLUDE_HPP
 #define _LCD_INCLUDE_HPP
 
-#define MAX_LCD_X 15  //!< Max cursor x coodirnate, limited by the horizontal length of the LCD
-#define MAX_LCD_Y 1   //!< Max cursor y coordinate, limited by the vertical len of LCD
+#define LCD_DDRAM_LEN 80  //!< characters the DDRAM holds, as 1 line or 2 lines of half of it
+#define LCD_DDRAM_LINE_LEN(isTwoLineMode) \
+  ((isTwoLineMode) ? (LCD_DDRAM_LEN / 2) : LCD_DDRAM_LEN)  //!< characters of a DDRAM line
 
 /* Timing Variable */
 
 #define COM_TIME_SCALER \
-  7000  //!< will be multiplied with timing parameters to prolong the duration, adjust as needed,
-        //!< too low and there might be problem as the lcd controller may not catch up
+  1  //!< the bus timing below will be multiplied with this when using PACING_FIXED_DELAY until
+     //!< timingCalibrate() picks one, raise it if the wiring is too slow for the datasheet timing,
+     //!< the execution time is waited for separately
 
 // waiting phase time
 #define LCD_WARM_UP_TIME_NANOSEC 49000000    //!< nanosec to wait for the LCD when it first wakes up
 #define LCD_FIRST_INIT_TIME_NANOSEC 4500000  //!< time to wait after first lcd contact
 #define LCD_SECOND_INIT_TIME_NANOSEC 150000  //!< time to wait after second lcd contact
 
-// data cycle time
-#define LCD_PULSE_WIDTH_NANOSEC 200 * COM_TIME_SCALER  //!< duration that the EN pin is stable high
-#define LCD_MIN_CYCLE_TIME_NANOSEC \
-  410 * COM_TIME_SCALER  //!< Min time in nanosec between two rising edge of EN pin
+// data cycle time, these are the datasheet values, they are scaled by the LcdDriver if needed
+#define LCD_PULSE_WIDTH_NANOSEC 200     //!< duration that the EN pin is stable high
+#define LCD_MIN_CYCLE_TIME_NANOSEC 410  //!< Min time in nanosec between two rising edge of EN pin
 
 // setup and hold time
 // for writing
-#define LCD_DATA_SETUP_TIME_NANOSEC \
-  45 * COM_TIME_SCALER  //!< time to hold data stable pre write transaction
-#define LCD_DATA_HOLD_TIME_NANOSEC \
-  15 * COM_TIME_SCALER  //!< time to hold data stable during transaction for write
+#define LCD_DATA_SETUP_TIME_NANOSEC 45  //!< time to hold data stable pre write transaction
+#define LCD_DATA_HOLD_TIME_NANOSEC 15   //!< time to hold data stable during transaction for write
 
 // for address based
 #define LCD_ADDR_SETUP_TIME_NANOSEC \
-  35 * COM_TIME_SCALER  //!< time to hold the RS, R/W line stable b4 transaction to properly indcate
-                        //!< target
+  35  //!< time to hold the RS, R/W line stable b4 transaction to properly indcate target
 
 #define LCD_ADDR_HOLD_TIME_NANOSEC \
-  15 * COM_TIME_SCALER  //!< time to hold the RS, R/W line stable during transaction to properly
-                        //!< indcate target
+  15  //!< time to hold the RS, R/W line stable during transaction to properly indcate target
 
 #define TIVA_MAX_RISE_TIME 13  //!< TIVA C max rise time for square wave if using 8mA drive strength
 #define TIVA_MAX_FALSE_TIME \
   14  //!< TIVA C max fall time for square wave if using 8mA drive strength
 
-/**
- * @brief wait time after a write during a transaction, combines many other timing section
- */
-#define LCD_DATA_WRITE_WAIT_NANOSEC \
-  TIVA_MAX_RISE_TIME + LCD_PULSE_WIDTH_NANOSEC - (LCD_DATA_SETUP_TIME_NANOSEC)
-
 #define LCD_DATA_READ_DELAY_NANOSEC \
   800  //!< nominal amount of time that the data output by the lcd controller will be available
 
+#define LCD_EXEC_TIME_NANOSEC \
+  37000  //!< time that the lcd controller takes to execute most instructions, except clear and home
+
+#define LCD_CLEAR_EXEC_TIME_NANOSEC \
+  1520000  //!< time that the lcd controller takes to execute the clear and home instructions
+
+#define LCD_ADDR_UPDATE_TIME_NANOSEC \
+  4000  //!< time that the lcd controller takes to update the address counter after a RAM access
+
+#define LCD_BUSY_POLL_TIMEOUT_NANOSEC \
+  2000000  //!< give up polling the busy flag after this long, longer than the slowest instruction
+
+/* Timing calibration */
+
+#define LCD_CALIBRATION_START_PERCENT \
+  800  //!< bus timing in percent of the datasheet that timingCalibrate() starts from and reads the
+       //!< pattern back with, it has to work with any wiring
+#define LCD_CALIBRATION_MIN_PERCENT \
+  40  //!< shortest timing tried, below it the rise time taken off the address setup goes negative
+#define LCD_CALIBRATION_STEP_PERCENT 75  //!< each step of timingCalibrate() keeps this much timing
+#define LCD_CALIBRATION_MARGIN_PERCENT \
+  50  //!< added on top of the shortest timing that worked, for temperature and supply drift
+#define LCD_CALIBRATION_LEN \
+  24  //!< bytes of test pattern written at the end of the first DDRAM line, it's hidden on a 8x1,
+      //!< 16x1 and 16x2, other panels show it until the reset at the end of timingCalibrate()
+#define LCD_CALIBRATION_PASS \
+  2  //!< times a step writes the pattern, each pass flips every bit of the previous one
+
+/* EEPROM record */
+
+#define LCD_EEPROM_ADDR \
+  0  //!< byte address of the LcdRecord in the EEPROM, has to be a multiple of 4
+
+/* Asynchronous transmit */
+
+#define LCD_TX_TIMER_BASE TIMER1_BASE             //!< timer clocking out queued bytes when isAsync
+#define LCD_TX_TIMER_CLOCK SYSCTL_PERIPH_TIMER1  //!< clock of LCD_TX_TIMER_BASE
+#define LCD_TX_TIMER_INT INT_TIMER1A             //!< interrupt of LCD_TX_TIMER_BASE
+#define LCD_TX_MIN_TIMER_NANOSEC \
+  2000  //!< delays shorter than this are spun inside the interrupt, it costs less than rearming
+#define LCD_TX_POLL_DELAY_LOOP \
+  20  //!< SysCtlDelay loops between two checks of the queue while waiting on the interrupt
+
+/* uDMA streaming, the control table and buffers only take RAM when LCD_DMA_STREAM is defined */
+
+#define LCD_DMA_CHANNEL UDMA_CH18_TIMER1A  //!< uDMA channel triggered by LCD_TX_TIMER_BASE
+#define LCD_DMA_SLOT_NANOSEC \
+  1000  //!< time between two uDMA writes to the lcd port, each step of the bus takes at least this
+#define LCD_DMA_WAVEFORM_LEN \
+  2048  //!< bytes of RAM holding the port values, has to fit a clear command(1.52 ms of slots)
+#define LCD_DMA_MAX_TRANSFER 1024  //!< max transfers that one uDMA task can do
+
 #define LCD_STARTUP_COMMAND 0b110000  //!< command to be written during the lcd wakeup
 #define LCD_BEGIN_COMMAND \
   0b100000  //!< command to be written to initiate the first configuration transaction for the lcd
@@ -65,6 +108,8 @@
 #define LCD_RETURN_HOME_COMMAND 0b10  //!< command to set cursor back at (0,0) without clearing data
 #define LCD_JUMP_LINE_COMMAND 0xc0    //!< command to jump to the beginning of the next line on lcd
 
+#define LCD_SPACE_CHAR 0x20  //!< what the DDRAM is filled with after a clear command
+
 #define LCD_BUSY_BIT 7  //!< the busy bit in the data returned from reading the lcd program data
 #define LCD_ADDR_COUNTER_MASK \
   0x7f  //!< bit mask for address counter in data received from the lcd controller program memory
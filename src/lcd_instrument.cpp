@@ -0,0 +1,96 @@
+/**
+ * @brief Implement the LcdDriver instrumentation, empty unless LCD_INSTRUMENT is defined
+ *
+ * @file lcd_instrument.cpp
+ * @author Khoi Trinh
+ * @date 2018-09-23
+ */
+
+#include "lcd_instrument.hpp"
+
+#ifdef LCD_INSTRUMENT
+
+#include <cassert>
+#include <cstdint>
+
+#include "utils/uartstdio.h"
+
+// application
+#include "general_timer/general_timer.hpp"
+
+namespace lcddriver {
+
+static const char *const INSTRUMENT_NAME_LIST[INSTRUMENT_TOTAL_POINT] = {"init",
+                                                                        "enable",
+                                                                        "enableStep",
+                                                                        "displayWrite",
+                                                                        "displayAppend",
+                                                                        "newCustomCharAdd",
+                                                                        "lcdSettingSwitch",
+                                                                        "lcdReset",
+                                                                        "cursorPositionChange",
+                                                                        "backLedSwitch",
+                                                                        "timingCalibrate",
+                                                                        "recordLoad",
+                                                                        "recordSave",
+                                                                        "flush",
+                                                                        "comSetup",
+                                                                        "comMaintain",
+                                                                        "comStop",
+                                                                        "parallelModeSwitch",
+                                                                        "pinWrite"};
+
+static LcdInstrumentRecord instrumentRecordList[INSTRUMENT_TOTAL_POINT];
+
+// floor of log2, 0 for 0
+static uint32_t bucketGet(uint32_t cycle) {
+  uint32_t bucket = 0;
+  for (uint32_t shift = 16; shift != 0; shift >>= 1) {
+    if (cycle >> shift) {
+      cycle >>= shift;
+      bucket += shift;
+    }
+  }
+  return bucket;
+}
+
+LcdInstrumentScope::LcdInstrumentScope(const LcdInstrumentPoint &point)
+    : _point(point), _startCycle(GeneralTimer::cycleCountGet()) {}
+
+LcdInstrumentScope::~LcdInstrumentScope() {
+  const uint32_t       elapsedCycle = GeneralTimer::cycleElapsedGet(_startCycle);
+  LcdInstrumentRecord &record       = instrumentRecordList[_point];
+  ++record.callCount;
+  ++record.cycleBucket[bucketGet(elapsedCycle)];
+}
+
+const LcdInstrumentRecord &lcdInstrumentRecordGet(const LcdInstrumentPoint &point) {
+  assert(point < INSTRUMENT_TOTAL_POINT);
+  return instrumentRecordList[point];
+}
+
+void lcdInstrumentDump(void) {
+  UARTprintf("lcd instrument: calls, then 2^bucket cycles:calls\n");
+  for (uint32_t point = 0; point < INSTRUMENT_TOTAL_POINT; ++point) {
+    const LcdInstrumentRecord &record = instrumentRecordList[point];
+    if (0 == record.callCount) { continue; }
+
+    UARTprintf("%s %u", INSTRUMENT_NAME_LIST[point], record.callCount);
+    for (uint32_t bucket = 0; bucket < LCD_INSTRUMENT_TOTAL_BUCKET; ++bucket) {
+      if (0 != record.cycleBucket[bucket]) {
+        UARTprintf(" %u:%u", bucket, record.cycleBucket[bucket]);
+      }
+    }
+    UARTprintf("\n");
+  }
+}
+
+void lcdInstrumentReset(void) {
+  for (uint32_t point = 0; point < INSTRUMENT_TOTAL_POINT; ++point) {
+    instrumentRecordList[point] = LcdInstrumentRecord();
+  }
+}
+
+}  // namespace lcddriver
+
+#endif
@@ -0,0 +1,106 @@
+/**
+ * @brief counts how many times each public LcdDriver method and each bus stage runs and how many
+ * core cycles it takes, only built when LCD_INSTRUMENT is defined, otherwise LCD_INSTRUMENT_SCOPE
+ * expands to nothing and the dump does nothing so it can stay in production code
+ *
+ * @file lcd_instrument.hpp
+ * @author Khoi Trinh
+ * @date 2018-09-23
+ */
+
+#ifndef _LCD_INSTRUMENT_HPP
+#define _LCD_INSTRUMENT_HPP
+
+#include <cstdint>
+
+namespace lcddriver {
+
+/**
+ * @brief what is measured, the time of a point includes the points it calls
+ */
+enum LcdInstrumentPoint : uint32_t {
+  INSTRUMENT_INIT,
+  INSTRUMENT_ENABLE,
+  INSTRUMENT_ENABLE_STEP,
+  INSTRUMENT_DISPLAY_WRITE,
+  INSTRUMENT_DISPLAY_APPEND,
+  INSTRUMENT_NEW_CUSTOM_CHAR_ADD,
+  INSTRUMENT_LCD_SETTING_SWITCH,
+  INSTRUMENT_LCD_RESET,
+  INSTRUMENT_CURSOR_POSITION_CHANGE,
+  INSTRUMENT_BACK_LED_SWITCH,
+  INSTRUMENT_TIMING_CALIBRATE,
+  INSTRUMENT_RECORD_LOAD,
+  INSTRUMENT_RECORD_SAVE,
+  INSTRUMENT_FLUSH,
+  INSTRUMENT_COM_SETUP,
+  INSTRUMENT_COM_MAINTAIN,
+  INSTRUMENT_COM_STOP,
+  INSTRUMENT_PARALLEL_MODE_SWITCH,
+  INSTRUMENT_PIN_WRITE,
+  INSTRUMENT_TOTAL_POINT
+};
+
+/**
+ * @brief buckets of the cycle histogram, bucket n counts the calls that took 2^n to 2^(n+1) - 1
+ * cycles, 0 cycle calls go to bucket 0
+ */
+static const uint32_t LCD_INSTRUMENT_TOTAL_BUCKET = 32;
+
+/**
+ * @brief what has been recorded for one point
+ */
+typedef struct {
+  uint32_t callCount;
+  uint32_t cycleBucket[LCD_INSTRUMENT_TOTAL_BUCKET];  //!< log2 histogram of the cycles per call
+} LcdInstrumentRecord;
+
+#ifdef LCD_INSTRUMENT
+
+/**
+ * @brief adds the cycles between its construction and destruction to a point, calls made from the
+ * tx interrupt may race with the ones of the main loop and get lost
+ */
+class LcdInstrumentScope {
+ private:
+  LcdInstrumentPoint _point;
+  uint32_t           _startCycle;
+
+ public:
+  LcdInstrumentScope(const LcdInstrumentPoint &point);
+  ~LcdInstrumentScope();
+};
+
+/**
+ * @brief measure the rest of the enclosing block as point
+ */
+#define LCD_INSTRUMENT_SCOPE(point) LcdInstrumentScope instrumentScope(point)
+
+/**
+ * @brief get what has been recorded for a point since the last reset
+ */
+const LcdInstrumentRecord &lcdInstrumentRecordGet(const LcdInstrumentPoint &point);
+
+/**
+ * @brief print every point that ran with UARTprintf, a line per point with the call count and the
+ * non empty buckets
+ */
+void lcdInstrumentDump(void);
+
+/**
+ * @brief clear every record
+ */
+void lcdInstrumentReset(void);
+
+#else
+
+#define LCD_INSTRUMENT_SCOPE(point)
+
+inline void lcdInstrumentDump(void) {}
+inline void lcdInstrumentReset(void) {}
+
+#endif
+
+}  // namespace lcddriver
+
+#endif
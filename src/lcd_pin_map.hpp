@@ -0,0 +1,227 @@
+/**
+ * @brief compile time description of the pins used by the lcd, everything about a pin(clock, port,
+ * data register address) is known to the compiler and invalid pins are rejected with static_assert
+ *
+ * @file lcd_pin_map.hpp
+ * @author Khoi Trinh
+ * @date 2018-09-23
+ */
+
+#ifndef _LCD_PIN_MAP_HPP
+#define _LCD_PIN_MAP_HPP
+
+#include <cstdint>
+
+// peripheral
+#include "driverlib/gpio.h"
+#include "driverlib/sysctl.h"
+
+// hardware
+#include "inc/hw_gpio.h"
+#include "inc/hw_memmap.h"
+
+namespace lcddriver {
+
+/**
+ * @brief check whether a port can be used by the lcd
+ * @param portBase the gpio port(like GPIO_PORTB_BASE)
+ * @return true if the port is one of port A-F
+ */
+constexpr bool lcdPortIsValid(const uint32_t portBase) {
+  return (GPIO_PORTA_BASE == portBase) || (GPIO_PORTB_BASE == portBase) ||
+         (GPIO_PORTC_BASE == portBase) || (GPIO_PORTD_BASE == portBase) ||
+         (GPIO_PORTE_BASE == portBase) || (GPIO_PORTF_BASE == portBase);
+}
+
+/**
+ * @brief get the clock of a gpio port
+ * @param portBase the gpio port(like GPIO_PORTB_BASE)
+ * @return uint32_t the clock of the port(like SYSCTL_PERIPH_GPIOB), 0 if the port is invalid
+ */
+constexpr uint32_t lcdPortClockGet(const uint32_t portBase) {
+  return (GPIO_PORTA_BASE == portBase)
+             ? SYSCTL_PERIPH_GPIOA
+             : (GPIO_PORTB_BASE == portBase)
+                   ? SYSCTL_PERIPH_GPIOB
+                   : (GPIO_PORTC_BASE == portBase)
+                         ? SYSCTL_PERIPH_GPIOC
+                         : (GPIO_PORTD_BASE == portBase)
+                               ? SYSCTL_PERIPH_GPIOD
+                               : (GPIO_PORTE_BASE == portBase)
+                                     ? SYSCTL_PERIPH_GPIOE
+                                     : (GPIO_PORTF_BASE == portBase) ? SYSCTL_PERIPH_GPIOF : 0;
+}
+
+/**
+ * @brief check for specially allocated pins that should not be used, like the JTAG, UART0 for
+ * debug, the crystal or locked pins
+ * @param portBase the gpio port(like GPIO_PORTB_BASE)
+ * @param pinMask the gpio pin(like GPIO_PIN_6)
+ * @return true if the pin is reserved
+ */
+constexpr bool lcdPinIsReserved(const uint32_t portBase, const uint32_t pinMask) {
+  return ((GPIO_PORTA_BASE == portBase) && (pinMask & (GPIO_PIN_0 | GPIO_PIN_1 | GPIO_PIN_2 |
+                                                       GPIO_PIN_3 | GPIO_PIN_4 | GPIO_PIN_5))) ||
+         ((GPIO_PORTB_BASE == portBase) && (pinMask & (GPIO_PIN_2 | GPIO_PIN_3))) ||
+         ((GPIO_PORTC_BASE == portBase) &&
+          (pinMask & (GPIO_PIN_0 | GPIO_PIN_1 | GPIO_PIN_2 | GPIO_PIN_3))) ||
+         ((GPIO_PORTD_BASE == portBase) && (pinMask & GPIO_PIN_7)) ||
+         ((GPIO_PORTF_BASE == portBase) && (pinMask & GPIO_PIN_0));
+}
+
+/**
+ * @brief a single gpio pin known at compile time, the clock is derived from the port so they can't
+ * mismatch
+ * @tparam PortBase the gpio port(like GPIO_PORTB_BASE)
+ * @tparam PinMask the gpio pin(like GPIO_PIN_6)
+ */
+template <uint32_t PortBase, uint8_t PinMask>
+struct LcdPin {
+  static_assert(lcdPortIsValid(PortBase), "lcd pins have to be on gpio port A-F");
+  static_assert((0 != PinMask) && (0 == (PinMask & (PinMask - 1))),
+                "lcd pin has to be a single GPIO_PIN_x");
+  static_assert(!lcdPinIsReserved(PortBase, PinMask),
+                "lcd pin is reserved by the TivaC(JTAG, UART0, crystal or locked pin)");
+
+  static const bool     isConnected = true;
+  static const uint32_t clock       = lcdPortClockGet(PortBase);
+  static const uint32_t port        = PortBase;
+  static const uint8_t  pin         = PinMask;
+
+  /**
+   * @brief address of the masked data register that only touches this pin
+   */
+  static const uint32_t dataAddr = PortBase + GPIO_O_DATA + (PinMask << 2);
+};
+
+/**
+ * @brief placeholder for a pin that is not connected, like the backlight on boards without one
+ */
+struct LcdNoPin {
+  static const bool     isConnected = false;
+  static const uint32_t clock       = 0;
+  static const uint32_t port        = 0;
+  static const uint8_t  pin         = 0;
+  static const uint32_t dataAddr    = 0;
+};
+
+/**
+ * @brief check whether two pins are the same one, not connected pins never collide
+ */
+template <class FirstPin, class SecondPin>
+constexpr bool lcdPinIsSame() {
+  return FirstPin::isConnected && SecondPin::isConnected && (FirstPin::port == SecondPin::port) &&
+         (FirstPin::pin == SecondPin::pin);
+}
+
+/**
+ * @brief the pin assignment of the lcd as a type, every member is an LcdPin
+ * Data pins that share a port are written together with one store, the tables for that are
+ * computed by the compiler
+ */
+template <class RegSelectPin,
+          class ReadWritePin,
+          class EnablePin,
+          class D4Pin,
+          class D5Pin,
+          class D6Pin,
+          class D7Pin,
+          class BackLightPin = LcdNoPin>
+struct LcdPinMap {
+  typedef RegSelectPin RegSelect;
+  typedef ReadWritePin ReadWrite;
+  typedef EnablePin    Enable;
+  typedef BackLightPin BackLight;
+
+  static_assert(RegSelectPin::isConnected && EnablePin::isConnected && D4Pin::isConnected &&
+                    D5Pin::isConnected && D6Pin::isConnected && D7Pin::isConnected,
+                "RS, EN and the data pins must be connected");
+  static_assert(!lcdPinIsSame<RegSelectPin, ReadWritePin>() &&
+                    !lcdPinIsSame<RegSelectPin, EnablePin>() &&
+                    !lcdPinIsSame<ReadWritePin, EnablePin>(),
+                "RS, RW and EN must be different pins");
+  static_assert(!lcdPinIsSame<D4Pin, D5Pin>() && !lcdPinIsSame<D4Pin, D6Pin>() &&
+                    !lcdPinIsSame<D4Pin, D7Pin>() && !lcdPinIsSame<D5Pin, D6Pin>() &&
+                    !lcdPinIsSame<D5Pin, D7Pin>() && !lcdPinIsSame<D6Pin, D7Pin>(),
+                "data pins must be different pins");
+
+  /**
+   * @brief port of a data pin
+   * @param dataPin 0 for D4, 3 for D7
+   */
+  static constexpr uint32_t dataPortGet(const uint32_t dataPin) {
+    return (0 == dataPin)
+               ? D4Pin::port
+               : (1 == dataPin) ? D5Pin::port : (2 == dataPin) ? D6Pin::port : D7Pin::port;
+  }
+
+  /**
+   * @brief mask of a data pin
+   * @param dataPin 0 for D4, 3 for D7
+   */
+  static constexpr uint8_t dataPinGet(const uint32_t dataPin) {
+    return (0 == dataPin) ? D4Pin::pin
+                          : (1 == dataPin) ? D5Pin::pin : (2 == dataPin) ? D6Pin::pin : D7Pin::pin;
+  }
+
+  /**
+   * @brief check whether a data pin is the first one on its port, only those do the port write
+   * @param dataPin 0 for D4, 3 for D7
+   */
+  static constexpr bool dataPortIsFirst(const uint32_t dataPin) {
+    return (0 == dataPin) || ((dataPortGet(0) != dataPortGet(dataPin)) &&
+                              ((1 == dataPin) || (dataPortGet(1) != dataPortGet(dataPin))) &&
+                              ((dataPin < 3) || (dataPortGet(2) != dataPortGet(dataPin))));
+  }
+
+  /**
+   * @brief mask of all data pins on the same port as a data pin
+   * @param dataPin 0 for D4, 3 for D7
+   */
+  static constexpr uint8_t dataPortMaskGet(const uint32_t dataPin) {
+    return ((dataPortGet(0) == dataPortGet(dataPin)) ? dataPinGet(0) : 0) |
+           ((dataPortGet(1) == dataPortGet(dataPin)) ? dataPinGet(1) : 0) |
+           ((dataPortGet(2) == dataPortGet(dataPin)) ? dataPinGet(2) : 0) |
+           ((dataPortGet(3) == dataPortGet(dataPin)) ? dataPinGet(3) : 0);
+  }
+
+  /**
+   * @brief address of the masked data register covering all data pins on the port of a data pin
+   * @param dataPin 0 for D4, 3 for D7
+   */
+  static constexpr uint32_t dataPortAddrGet(const uint32_t dataPin) {
+    return dataPortGet(dataPin) + GPIO_O_DATA + (dataPortMaskGet(dataPin) << 2);
+  }
+
+  /**
+   * @brief what to write to the port of a data pin to output a nibble
+   * @param dataPin 0 for D4, 3 for D7
+   * @param nibble the nibble to output
+   */
+  static constexpr uint8_t nibbleOutputGet(const uint32_t dataPin, const uint8_t nibble) {
+    return (((nibble & 0x1) && (dataPortGet(0) == dataPortGet(dataPin))) ? dataPinGet(0) : 0) |
+           (((nibble & 0x2) && (dataPortGet(1) == dataPortGet(dataPin))) ? dataPinGet(1) : 0) |
+           (((nibble & 0x4) && (dataPortGet(2) == dataPortGet(dataPin))) ? dataPinGet(2) : 0) |
+           (((nibble & 0x8) && (dataPortGet(3) == dataPortGet(dataPin))) ? dataPinGet(3) : 0);
+  }
+};
+
+/**
+ * @brief the nibble to port value table of every data port of a pin map, built by the compiler
+ */
+template <class PinMap>
+struct LcdNibbleTable {
+  uint8_t output[4][16];  //!< indexed by the data pin(0 for D4) and the nibble
+
+  constexpr LcdNibbleTable() : output() {
+    for (uint32_t dataPin = 0; dataPin < 4; ++dataPin) {
+      for (uint8_t nibble = 0; nibble < 16; ++nibble) {
+        output[dataPin][nibble] = PinMap::nibbleOutputGet(dataPin, nibble);
+      }
+    }
+  }
+};
+
+}  // namespace lcddriver
+
+#endif
@@ -0,0 +1,39 @@
+/**
+ * @brief Implement the encoding and decoding of the LcdDriver EEPROM record
+ *
+ * @file lcd_record.cpp
+ * @author Khoi Trinh
+ * @date 2018-09-23
+ */
+
+#include "lcd_record.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+#include "driverlib/sw_crc.h"
+
+namespace lcddriver {
+
+static uint32_t recordCrcGet(const LcdRecord &record) {
+  // standard CRC-32, the seed and the final inversion are left to the caller of Crc32
+  return Crc32(0xffffffff, (const uint8_t *)&record, offsetof(LcdRecord, crc)) ^ 0xffffffff;
+}
+
+void lcdRecordEncode(const LcdRecordContent &content, LcdRecord &record) {
+  record.magic   = LCD_RECORD_MAGIC;
+  record.version = LCD_RECORD_VERSION;
+  record.content = content;
+  record.crc     = recordCrcGet(record);
+}
+
+bool lcdRecordDecode(const LcdRecord &record, LcdRecordContent &content) {
+  if ((LCD_RECORD_MAGIC != record.magic) || (LCD_RECORD_VERSION != record.version) ||
+      (recordCrcGet(record) != record.crc)) {
+    return false;
+  }
+  content = record.content;
+  return true;
+}
+
+}  // namespace lcddriver
@@ -0,0 +1,76 @@
+/**
+ * @brief the record that the LcdDriver keeps in the TivaC EEPROM so a boot can skip the calibration
+ * and the custom character upload, encoding and decoding don't touch any peripheral so they can
+ * run on the host
+ *
+ * @file lcd_record.hpp
+ * @author Khoi Trinh
+ * @date 2018-09-23
+ */
+
+#ifndef _LCD_RECORD_HPP
+#define _LCD_RECORD_HPP
+
+#include <cstdint>
+
+namespace lcddriver {
+
+/**
+ * @brief "LCDR", tells a record apart from an erased or foreign EEPROM block
+ */
+static const uint32_t LCD_RECORD_MAGIC = 0x5244434c;
+
+/**
+ * @brief raised each time the layout of LcdRecordContent changes, older records are ignored
+ */
+static const uint32_t LCD_RECORD_VERSION = 1;
+
+/**
+ * @brief custom character slots kept in a record, the 8 of the 5x8 font
+ */
+static const uint32_t LCD_RECORD_TOTAL_CHAR = 8;
+
+/**
+ * @brief bytes of a custom character pattern
+ */
+static const uint32_t LCD_RECORD_CHAR_LEN = 8;
+
+/**
+ * @brief what the record holds
+ */
+typedef struct {
+  uint32_t timingPercent;   //!< bus timing in percent of the datasheet
+  uint32_t customCharUsed;  //!< bit per slot that has a pattern
+  uint8_t  customCharList[LCD_RECORD_TOTAL_CHAR][LCD_RECORD_CHAR_LEN];
+} LcdRecordContent;
+
+/**
+ * @brief the record as it's stored, whole 32 bit words as the EEPROM is programmed by words
+ */
+typedef struct {
+  uint32_t         magic;
+  uint32_t         version;
+  LcdRecordContent content;
+  uint32_t         crc;  //!< CRC-32 of everything b4 it
+} LcdRecord;
+
+static_assert(0 == sizeof(LcdRecord) % 4, "LcdRecord has to be whole words");
+
+/**
+ * @brief fill a record with content and seal it
+ * @param content what to store
+ * @param record the record to fill
+ */
+void lcdRecordEncode(const LcdRecordContent &content, LcdRecord &record);
+
+/**
+ * @brief check a record and take its content out
+ * @param record the record as read back
+ * @param content filled only if the record is valid
+ * @return false if the magic, version or CRC don't match
+ */
+bool lcdRecordDecode(const LcdRecord &record, LcdRecordContent &content);
+
+}  // namespace lcddriver
+
+#endif
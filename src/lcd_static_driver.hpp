@@ -0,0 +1,292 @@
+/**
+ * @brief header only lcd driver whose pin assignment is a compile time LcdPinMap, every pin access
+ * becomes a single store to a constant address and the config takes no RAM
+ *
+ * @file lcd_static_driver.hpp
+ * @author Khoi Trinh
+ * @date 2018-09-23
+ */
+
+#ifndef _LCD_STATIC_DRIVER_HPP
+#define _LCD_STATIC_DRIVER_HPP
+
+#include <cassert>
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+
+// peripheral
+#include "driverlib/gpio.h"
+#include "driverlib/sysctl.h"
+
+// hardware
+#include "inc/hw_types.h"
+
+// application
+#include "general_timer/general_timer.hpp"
+#include "lcd_driver.hpp"
+#include "lcd_include.hpp"
+#include "lcd_pin_map.hpp"
+#include "tiva_utils/bit_manipulation.h"
+
+#ifdef LCD_HOST_SIM
+// the host simulator has no gpio registers, it provides the stores to the masked data registers
+void simGpioRegWrite(uint32_t regAddr, uint8_t value);
+#define LCD_STATIC_REG_WRITE(regAddr, value) simGpioRegWrite(regAddr, value)
+#else
+#define LCD_STATIC_REG_WRITE(regAddr, value) (HWREG(regAddr) = (value))
+#endif
+
+namespace lcddriver {
+
+/**
+ * @brief alternative front end to LcdDriver for when the pins are known at compile time
+ * It only writes to a 16x2 lcd over a 4 bit bus(R/W is held low, it can be LcdNoPin if tied to
+ * ground), paces the controller with the datasheet execution time and uses the datasheet bus
+ * timing, the waits are converted to timer ticks by the compiler so the system clock has to be
+ * GENERAL_TIMER_CLOCK_HZ, example:
+ *
+ * typedef LcdPinMap<LcdPin<GPIO_PORTB_BASE, GPIO_PIN_7>,  // RS
+ *                   LcdPin<GPIO_PORTF_BASE, GPIO_PIN_4>,  // RW
+ *                   LcdPin<GPIO_PORTE_BASE, GPIO_PIN_3>,  // EN
+ *                   LcdPin<GPIO_PORTE_BASE, GPIO_PIN_2>,  // D4
+ *                   LcdPin<GPIO_PORTE_BASE, GPIO_PIN_1>,  // D5
+ *                   LcdPin<GPIO_PORTE_BASE, GPIO_PIN_0>,  // D6
+ *                   LcdPin<GPIO_PORTD_BASE, GPIO_PIN_6>>  // D7
+ *     BoardPinMap;
+ * LcdStaticDriver<BoardPinMap> lcdDriver;
+ *
+ * @tparam PinMap an LcdPinMap describing the pins
+ */
+template <class PinMap>
+class LcdStaticDriver {
+ private:
+  /**
+   * @brief Instance of general timer used for all timing purposes
+   */
+  GeneralTimer _generalTimer;
+
+  /**
+   * @brief nibble to port value tables, in flash since they're computed by the compiler
+   */
+  static constexpr LcdNibbleTable<PinMap> _nibbleTable = LcdNibbleTable<PinMap>();
+
+  /**
+   * @brief turn on the clock of the pin port and make the pin an output with 8 mA drive
+   */
+  template <class Pin>
+  static void pinInit(void) {
+    if (!Pin::isConnected) { return; }
+    const uint32_t clock = Pin::clock;
+    SysCtlPeripheralEnable(clock);
+    while (!SysCtlPeripheralReady(clock)) {
+      // wait for clock to be ready
+    }
+    GPIOPinTypeGPIOOutput(Pin::port, Pin::pin);
+    GPIOPadConfigSet(Pin::port, Pin::pin, GPIO_STRENGTH_8MA, GPIO_PIN_TYPE_STD);
+  }
+
+  /**
+   * @brief switch on/off a pin, compiles to a single store
+   */
+  template <class Pin>
+  static void pinWrite(const bool &output) {
+    if (Pin::isConnected) { LCD_STATIC_REG_WRITE(Pin::dataAddr, output ? Pin::pin : 0); }
+  }
+
+  /**
+   * @brief output a nibble on the port of a data pin if it's the first data pin of that port
+   */
+  template <uint32_t DataPin>
+  static void dataPortWrite(const uint8_t &nibble) {
+    if (PinMap::dataPortIsFirst(DataPin)) {
+      LCD_STATIC_REG_WRITE(PinMap::dataPortAddrGet(DataPin),
+                           _nibbleTable.output[DataPin][nibble & 0xf]);
+    }
+  }
+
+  /**
+   * @brief put a nibble on D4-D7 and strobe EN
+   */
+  void nibbleWrite(const uint8_t &nibble) {
+    dataPortWrite<0>(nibble);
+    dataPortWrite<1>(nibble);
+    dataPortWrite<2>(nibble);
+    dataPortWrite<3>(nibble);
+    _generalTimer.waitConst<LCD_ADDR_SETUP_TIME_NANOSEC>();
+    pinWrite<typename PinMap::Enable>(true);
+    _generalTimer.waitConst<LCD_PULSE_WIDTH_NANOSEC>();
+    pinWrite<typename PinMap::Enable>(false);
+    _generalTimer.waitConst<LCD_MIN_CYCLE_TIME_NANOSEC - LCD_PULSE_WIDTH_NANOSEC>();
+  }
+
+  /**
+   * @brief write a byte as 2 nibbles then wait for the controller to execute it
+   * @param data the byte to write
+   * @param isDataReg true if the byte goes to the RAM, false if it's an instruction
+   */
+  void byteWrite(const uint8_t &data, const bool &isDataReg) {
+    pinWrite<typename PinMap::RegSelect>(isDataReg);
+    nibbleWrite(data >> 4);
+    nibbleWrite(data);
+    const bool isLongInstruction =
+        !isDataReg && ((LCD_CLEAR_COMMAND == data) || (LCD_RETURN_HOME_COMMAND == (data & 0xfe)));
+    if (isLongInstruction) {
+      _generalTimer.waitConst<LCD_CLEAR_EXEC_TIME_NANOSEC>();
+    } else if (isDataReg) {
+      // the address counter moves after the RAM access
+      _generalTimer.waitConst<LCD_EXEC_TIME_NANOSEC + LCD_ADDR_UPDATE_TIME_NANOSEC>();
+    } else {
+      _generalTimer.waitConst<LCD_EXEC_TIME_NANOSEC>();
+    }
+  }
+
+ public:
+  /**
+   * @brief Construct a new Lcd Static Driver object, doesn't touch the hardware
+   */
+  LcdStaticDriver() : _generalTimer(GeneralTimer(UNIT_NANOSEC)) {}
+
+  /**
+   * @brief Initialize the lcd driver, by turning on all gpio clocks and set the gpio mode to be
+   * ready to drive the lcd
+   */
+  void init(void) {
+    pinInit<typename PinMap::RegSelect>();
+    pinInit<typename PinMap::ReadWrite>();
+    pinInit<typename PinMap::Enable>();
+    pinInit<typename PinMap::BackLight>();
+    for (uint32_t dataPin = 0; dataPin < 4; ++dataPin) {
+      const uint32_t portBase = PinMap::dataPortGet(dataPin);
+      const uint32_t clock    = lcdPortClockGet(portBase);
+      SysCtlPeripheralEnable(clock);
+      while (!SysCtlPeripheralReady(clock)) {
+        // wait for clock to be ready
+      }
+      GPIOPinTypeGPIOOutput(portBase, PinMap::dataPinGet(dataPin));
+    }
+
+    // only writing so R/W stays low
+    pinWrite<typename PinMap::ReadWrite>(false);
+    pinWrite<typename PinMap::Enable>(false);
+  }
+
+  /**
+   * @brief Start communicating with the lcd and write settings to the lcd controller, same
+   * sequence as LcdDriver::enable
+   */
+  void enable(void) {
+    _generalTimer.waitConst<LCD_WARM_UP_TIME_NANOSEC>();
+
+    pinWrite<typename PinMap::RegSelect>(false);
+    nibbleWrite(LCD_STARTUP_COMMAND >> 4);
+    _generalTimer.waitConst<LCD_FIRST_INIT_TIME_NANOSEC>();
+    nibbleWrite(LCD_STARTUP_COMMAND >> 4);
+    _generalTimer.waitConst<LCD_SECOND_INIT_TIME_NANOSEC>();
+    nibbleWrite(LCD_STARTUP_COMMAND >> 4);
+    _generalTimer.waitConst<LCD_EXEC_TIME_NANOSEC>();
+    nibbleWrite(LCD_BEGIN_COMMAND >> 4);
+    _generalTimer.waitConst<LCD_EXEC_TIME_NANOSEC>();
+
+    // 4 bit, 2 lines, 5x8 font, then display/cursor/blink on, clear and move right
+    byteWrite(LCD_BEGIN_COMMAND | BIT(3), false);
+    byteWrite(BIT(3) | BIT(2) | BIT(1) | BIT(0), false);
+    byteWrite(LCD_CLEAR_COMMAND, false);
+    byteWrite(BIT(2) | BIT(1), false);
+  }
+
+  /**
+   * @brief Erase the display and add new text to it starting at position (0,0), same text format
+   * as LcdDriver::displayWrite
+   * @param dataToWrite character array reprenting string to print, limited at LCD_MAX_PRINT_STRING
+   */
+  void displayWrite(const char *dataToWrite) {
+    lcdReset();
+    displayAppend(dataToWrite);
+  }
+
+  /**
+   * @brief Append text where the cursor currently is, same text format as
+   * LcdDriver::displayAppend
+   * @param dataToAppend character array reprenting string to print, limited at LCD_MAX_PRINT_STRING
+   */
+  void displayAppend(const char *dataToAppend) {
+    assert(dataToAppend);
+    assert(LCD_MAX_PRINT_STRING >= strlen(dataToAppend));
+
+    const uint32_t dataLen = strlen(dataToAppend);
+    for (uint32_t strIndex = 0; strIndex < dataLen; ++strIndex) {
+      const uint8_t currChar = dataToAppend[strIndex];
+      if ('\n' == currChar) {
+        byteWrite(LCD_JUMP_LINE_COMMAND, false);
+      } else if (('`' == currChar) && (strIndex < dataLen - 1) &&
+                 isdigit(dataToAppend[strIndex + 1]) &&
+                 ((uint32_t)(dataToAppend[strIndex + 1] - '0') < MAX_TOTAL_CUSTOM_PATTERN)) {
+        byteWrite(dataToAppend[++strIndex] - '0', true);
+      } else if (!isspace(currChar) || (' ' == currChar)) {
+        byteWrite(currChar, true);
+      }
+    }
+  }
+
+  /**
+   * @brief Add new custom character pattern, check LcdDriver::newCustomCharAdd
+   * @param charPattern array storing the byte patterns
+   * @param customCharSlot what slot to store the new pattern at
+   */
+  void newCustomCharAdd(const uint8_t   charPattern[CUSTOM_CHAR_PATTERN_LEN],
+                        const uint32_t &customCharSlot) {
+    assert(customCharSlot < MAX_TOTAL_CUSTOM_PATTERN);
+    assert(charPattern);
+
+    byteWrite(BIT(6) | (customCharSlot * LCD_MEMUSED_PER_x8_CHAR), false);
+    for (uint32_t patternIndex = 0; patternIndex < CUSTOM_CHAR_PATTERN_LEN; ++patternIndex) {
+      byteWrite(charPattern[patternIndex], true);
+    }
+    // go back to DDRAM so text can be appended
+    byteWrite(BIT(7), false);
+  }
+
+  /**
+   * @brief Change lcd settings like on/off display, cursor, or blinking mode
+   * @param displayOn display on if true, off otherwise
+   * @param cursorOn cursor on if true, off otherwise
+   * @param cursorBlinkOn cursor blinking on if true, off otherwise
+   */
+  void lcdSettingSwitch(const bool &displayOn, const bool &cursorOn, const bool &cursorBlinkOn) {
+    byteWrite(BIT(3) | (displayOn ? BIT(2) : 0) | (cursorOn ? BIT(1) : 0) |
+                  (cursorBlinkOn ? BIT(0) : 0),
+              false);
+  }
+
+  /**
+   * @brief reset the LCD and erase all RAM, also reset cursor to (0,0)
+   */
+  void lcdReset(void) { byteWrite(LCD_CLEAR_COMMAND, false); }
+
+  /**
+   * @brief Change cursor position on an x-y scale
+   * @param cursorX x coordinate to set
+   * @param cursorY y coordinate to set
+   */
+  void cursorPositionChange(const uint8_t &cursorX, const uint8_t &cursorY) {
+    assert(cursorX < LCD_GEOMETRY_16X2.totalColumn && cursorY < LCD_GEOMETRY_16X2.totalRow);
+    byteWrite(BIT(7) | (LCD_GEOMETRY_16X2.rowAddrList[cursorY] + cursorX), false);
+  }
+
+  /**
+   * @brief Turn on or off the back light LED
+   * @param isBackLedOn turn on LED if true, off otherwise
+   */
+  void backLedSwitch(const bool &isBackLedOn) {
+    static_assert(PinMap::BackLight::isConnected, "the pin map has no backlight pin");
+    pinWrite<typename PinMap::BackLight>(isBackLedOn);
+  }
+};
+
+template <class PinMap>
+constexpr LcdNibbleTable<PinMap> LcdStaticDriver<PinMap>::_nibbleTable;
+
+}  // namespace lcddriver
+
+#endif
@@ -0,0 +1,90 @@
+/**
+ * @brief Implement the LcdDriver pin trace, empty unless LCD_TRACE is defined
+ *
+ * @file lcd_trace.cpp
+ * @author Khoi Trinh
+ * @date 2018-09-23
+ */
+
+#include "lcd_trace.hpp"
+
+#ifdef LCD_TRACE
+
+#include <cstdint>
+
+// peripheral
+#include "driverlib/sysctl.h"
+#include "utils/uartstdio.h"
+
+// application
+#include "general_timer/general_timer.hpp"
+
+namespace lcddriver {
+
+static_assert(0 == (LCD_TRACE_LEN & (LCD_TRACE_LEN - 1)), "LCD_TRACE_LEN has to be a power of 2");
+
+static const uint32_t LCD_TRACE_MASK = LCD_TRACE_LEN - 1;
+
+static LcdTraceEvent     traceEventList[LCD_TRACE_LEN];
+static volatile uint32_t traceHead    = 0;  // next event to read, only changed by lcdTraceRead()
+static volatile uint32_t traceTail    = 0;  // next free slot, only changed by lcdTracePinRecord()
+static volatile uint32_t traceDropped = 0;
+
+// level + 1 of every signal, 0 until it's first written so that write is always recorded
+static uint8_t traceLevelList[TRACE_TOTAL_SIGNAL];
+
+void lcdTracePinRecord(const LcdTraceSignal &signal, const uint8_t &level) {
+  if ((level + 1) == traceLevelList[signal]) { return; }
+
+  // a dropped change keeps the old level so the next write of the new one is still recorded
+  const uint32_t tail = traceTail;
+  if (((tail + 1) & LCD_TRACE_MASK) == traceHead) {
+    ++traceDropped;
+    return;
+  }
+
+  LcdTraceEvent &event   = traceEventList[tail];
+  event.tick             = GeneralTimer::tickGet();
+  event.signal           = signal;
+  event.level            = level;
+  traceLevelList[signal] = level + 1;
+  traceTail              = (tail + 1) & LCD_TRACE_MASK;
+}
+
+bool lcdTraceRead(LcdTraceEvent &event) {
+  const uint32_t head = traceHead;
+  if (head == traceTail) { return false; }
+
+  event     = traceEventList[head];
+  traceHead = (head + 1) & LCD_TRACE_MASK;
+  return true;
+}
+
+uint32_t lcdTraceDroppedGet(void) { return traceDropped; }
+
+void lcdTraceReset(void) {
+  traceHead    = 0;
+  traceTail    = 0;
+  traceDropped = 0;
+  for (uint32_t signal = 0; signal < TRACE_TOTAL_SIGNAL; ++signal) { traceLevelList[signal] = 0; }
+}
+
+void lcdTraceDump(void) {
+  static const char LEVEL_CHAR_LIST[] = {'0', '1', 'z'};
+
+  UARTprintf("lcd trace %u\n", SysCtlClockGet());
+  LcdTraceEvent event;
+  while (lcdTraceRead(event)) {
+    // UARTprintf has no 64 bit conversion
+    UARTprintf("%08x%08x %s %c\n",
+               (uint32_t)(event.tick >> 32),
+               (uint32_t)event.tick,
+               lcdTraceSignalNameGet(event.signal),
+               LEVEL_CHAR_LIST[event.level]);
+  }
+  UARTprintf("lcd trace end %u\n", lcdTraceDroppedGet());
+}
+
+}  // namespace lcddriver
+
+#endif
@@ -0,0 +1,137 @@
+/**
+ * @brief timestamps every level change the LcdDriver makes on the lcd pins into a ring buffer, only
+ * built when LCD_TRACE is defined, otherwise LCD_TRACE_PIN expands to nothing, the event layout and
+ * the signal names are always there for the host tool that turns a dump into a VCD file
+ *
+ * @file lcd_trace.hpp
+ * @author Khoi Trinh
+ * @date 2018-09-23
+ */
+
+#ifndef _LCD_TRACE_HPP
+#define _LCD_TRACE_HPP
+
+#include <cstdint>
+
+namespace lcddriver {
+
+/**
+ * @brief the pins that are traced, D0-D3 only change with an 8 bit bus and EN1-EN3 with more than
+ * one controller
+ */
+enum LcdTraceSignal : uint8_t {
+  TRACE_SIGNAL_RS,
+  TRACE_SIGNAL_RW,
+  TRACE_SIGNAL_EN,
+  TRACE_SIGNAL_BACK_LIGHT,
+  TRACE_SIGNAL_D4,
+  TRACE_SIGNAL_D5,
+  TRACE_SIGNAL_D6,
+  TRACE_SIGNAL_D7,
+  TRACE_SIGNAL_D0,
+  TRACE_SIGNAL_D1,
+  TRACE_SIGNAL_D2,
+  TRACE_SIGNAL_D3,
+  TRACE_SIGNAL_EN1,
+  TRACE_SIGNAL_EN2,
+  TRACE_SIGNAL_EN3,
+  TRACE_TOTAL_SIGNAL
+};
+
+/**
+ * @brief level of a pin that the driver stopped driving, the data pins while they are input
+ */
+static const uint8_t LCD_TRACE_LEVEL_FLOAT = 2;
+
+/**
+ * @brief how many events the ring buffer holds, has to be a power of 2
+ */
+#ifndef LCD_TRACE_LEN
+#define LCD_TRACE_LEN 512
+#endif
+
+/**
+ * @brief one level change
+ */
+typedef struct {
+  uint64_t tick;    //!< GeneralTimer tick when the pin was written
+  uint8_t  signal;  //!< LcdTraceSignal
+  uint8_t  level;   //!< 0, 1 or LCD_TRACE_LEVEL_FLOAT
+} LcdTraceEvent;
+
+/**
+ * @brief name of a signal as it shows in the dump and the VCD file
+ */
+inline const char *lcdTraceSignalNameGet(const uint8_t &signal) {
+  static const char *const TRACE_SIGNAL_NAME_LIST[TRACE_TOTAL_SIGNAL] = {
+      "rs", "rw", "en", "back_light", "d4", "d5", "d6", "d7", "d0", "d1", "d2", "d3", "en1", "en2",
+      "en3"};
+  return (signal < TRACE_TOTAL_SIGNAL) ? TRACE_SIGNAL_NAME_LIST[signal] : nullptr;
+}
+
+/**
+ * @brief signal of a data pin
+ * @param dataBit bit of the byte that the pin carries, 4 for D4
+ */
+inline LcdTraceSignal lcdTraceDataSignalGet(const uint32_t &dataBit) {
+  return (LcdTraceSignal)((dataBit < 4) ? (TRACE_SIGNAL_D0 + dataBit)
+                                        : (TRACE_SIGNAL_D4 + dataBit - 4));
+}
+
+/**
+ * @brief signal of the EN pin of a controller
+ * @param controller index of the controller, EN is the one of the first
+ */
+inline LcdTraceSignal lcdTraceEnableSignalGet(const uint32_t &controller) {
+  return (0 == controller) ? TRACE_SIGNAL_EN
+                           : (LcdTraceSignal)(TRACE_SIGNAL_EN1 + controller - 1);
+}
+
+#ifdef LCD_TRACE
+
+/**
+ * @brief record a pin write if it changes the level of the signal, only one context may record at a
+ * time, the driver never drives the bus from the main loop and the tx interrupt together
+ */
+void lcdTracePinRecord(const LcdTraceSignal &signal, const uint8_t &level);
+
+/**
+ * @brief record a pin write
+ */
+#define LCD_TRACE_PIN(signal, level) lcdTracePinRecord(signal, level)
+
+/**
+ * @brief take the oldest event out of the buffer, can run while events are recorded
+ * @return false if the buffer is empty
+ */
+bool lcdTraceRead(LcdTraceEvent &event);
+
+/**
+ * @brief how many events didn't fit since the last reset, the newest ones are the ones dropped
+ */
+uint32_t lcdTraceDroppedGet(void);
+
+/**
+ * @brief empty the buffer and forget the levels so the next write of every pin is recorded, can't
+ * run while events are recorded
+ */
+void lcdTraceReset(void);
+
+/**
+ * @brief read every event out with UARTprintf, "lcd trace <tick Hz>" then a
+ * "<tick in hex> <signal name> <level 0, 1 or z>" line per event and "lcd trace end <dropped>"
+ */
+void lcdTraceDump(void);
+
+#else
+
+#define LCD_TRACE_PIN(signal, level)
+
+inline void lcdTraceReset(void) {}
+inline void lcdTraceDump(void) {}
+
+#endif
+
+}  // namespace lcddriver
+
+#endif
@@ -0,0 +1,130 @@
+/**
+ * @brief Implement the LcdTxEngine state machine, everything TivaC specific stays in LcdDriver
+ *
+ * @file lcd_tx_engine.cpp
+ * @author Khoi Trinh
+ * @date 2018-09-23
+ */
+
+#include "lcd_tx_engine.hpp"
+
+#include <cassert>
+#include <cstdint>
+
+namespace lcddriver {
+
+static const uint32_t LCD_TX_QUEUE_MASK = LCD_TX_QUEUE_LEN - 1;
+
+// clear display is 0x01, return home is 0x02 or 0x03
+static const uint8_t LCD_TX_LONG_INSTRUCTION_MAX = 0x03;
+
+LcdTxEngine::LcdTxEngine(LcdTxBus* bus)
+    : _bus(bus),
+      _timing(LcdTxTiming()),
+      _strobePerByte(2),
+      _queueHead(0),
+      _queueTail(0),
+      _isRunning(false),
+      _state(TX_STATE_IDLE),
+      _currItem(LcdTxItem()),
+      _strobeIndex(0),
+      _idleCallback(nullptr),
+      _idleCallbackContext(nullptr) {
+  static_assert(0 == (LCD_TX_QUEUE_LEN & LCD_TX_QUEUE_MASK), "queue len has to be a power of 2");
+  assert(bus);
+}
+
+void LcdTxEngine::configure(const LcdTxTiming& timing, const uint32_t& strobePerByte) {
+  assert(isIdle());
+  assert((1 == strobePerByte) || (2 == strobePerByte));
+  _timing        = timing;
+  _strobePerByte = strobePerByte;
+}
+
+void LcdTxEngine::busSet(LcdTxBus* bus) {
+  assert(isIdle());
+  assert(bus);
+  _bus = bus;
+}
+
+void LcdTxEngine::idleCallbackSet(LcdTxCallback callback, void* context) {
+  _idleCallback        = callback;
+  _idleCallbackContext = context;
+}
+
+bool LcdTxEngine::itemPush(const uint8_t& data, const bool& isDataReg) {
+  const uint32_t tail = _queueTail;
+  if (((tail + 1) & LCD_TX_QUEUE_MASK) == _queueHead) { return false; }
+
+  _queue[tail].data      = data;
+  _queue[tail].isDataReg = isDataReg;
+  _queueTail             = (tail + 1) & LCD_TX_QUEUE_MASK;
+  return true;
+}
+
+bool LcdTxEngine::start(void) {
+  if (_isRunning || (_queueHead == _queueTail)) { return false; }
+  _isRunning = true;
+  _state     = TX_STATE_SETUP;
+  return true;
+}
+
+uint8_t LcdTxEngine::strobeValueGet(void) {
+  // high nibble goes first
+  return _currItem.data >> ((8 / _strobePerByte) * (_strobePerByte - 1 - _strobeIndex));
+}
+
+uint32_t LcdTxEngine::execTimeGet(const LcdTxItem& item) {
+  if (item.isDataReg) { return _timing.ramExecTime; }
+  return (item.data <= LCD_TX_LONG_INSTRUCTION_MAX) ? _timing.longExecTime : _timing.execTime;
+}
+
+bool LcdTxEngine::nextItemTimeGet(uint32_t& totalTime, uint32_t& totalStep) {
+  if (_queueHead == _queueTail) { return false; }
+
+  totalTime = _timing.addrSetupTime + _strobePerByte * _timing.pulseWidth +
+              (_strobePerByte - 1) * _timing.enableLowTime + execTimeGet(_queue[_queueHead]);
+  totalStep = 2 * _strobePerByte + 1;
+  return true;
+}
+
+uint32_t LcdTxEngine::tick(void) {
+  switch (_state) {
+    case TX_STATE_SETUP:
+      if (_queueHead == _queueTail) {
+        // the last byte has been executed
+        _state     = TX_STATE_IDLE;
+        _isRunning = false;
+        if (_idleCallback) { _idleCallback(_idleCallbackContext); }
+        return 0;
+      }
+      _currItem    = _queue[_queueHead];
+      _queueHead   = (_queueHead + 1) & LCD_TX_QUEUE_MASK;
+      _strobeIndex = 0;
+      _bus->txRegisterSelect(_currItem.isDataReg);
+      _bus->txDataPut(strobeValueGet());
+      _state = TX_STATE_ENABLE_HIGH;
+      return _timing.addrSetupTime;
+
+    case TX_STATE_ENABLE_HIGH:
+      _bus->txEnableSwitch(true);
+      _state = TX_STATE_ENABLE_LOW;
+      return _timing.pulseWidth;
+
+    case TX_STATE_ENABLE_LOW:
+      _bus->txEnableSwitch(false);
+      ++_strobeIndex;
+      if (_strobeIndex < _strobePerByte) {
+        _bus->txDataPut(strobeValueGet());
+        _state = TX_STATE_ENABLE_HIGH;
+        return _timing.enableLowTime;
+      }
+      _state = TX_STATE_SETUP;
+      return execTimeGet(_currItem);
+
+    default:
+      return 0;
+  }
+}
+
+}  // namespace lcddriver
@@ -0,0 +1,183 @@
+/**
+ * @brief state machine that clocks queued bytes out to the lcd controller one EN edge at a time, it
+ * doesn't touch any TivaC peripheral so it can run from a timer interrupt or from a host test
+ *
+ * @file lcd_tx_engine.hpp
+ * @author Khoi Trinh
+ * @date 2018-09-23
+ */
+
+#ifndef _LCD_TX_ENGINE_HPP
+#define _LCD_TX_ENGINE_HPP
+
+#include <cstdint>
+
+namespace lcddriver {
+
+/**
+ * @brief how many bytes can be waiting to be sent, has to be a power of 2
+ */
+static const uint32_t LCD_TX_QUEUE_LEN = 64;
+
+/**
+ * @brief function called by the LcdTxEngine once every queued byte is done
+ * @param context the pointer given together with the callback
+ */
+typedef void (*LcdTxCallback)(void *context);
+
+/**
+ * @brief timing used by the LcdTxEngine, all in nanosec
+ */
+typedef struct {
+  uint32_t addrSetupTime;  //!< RS, R/W and data stable b4 EN goes high
+  uint32_t pulseWidth;     //!< time that EN is high
+  uint32_t enableLowTime;  //!< time that EN is low between two nibbles of the same byte
+  uint32_t execTime;       //!< time for the controller to execute an instruction
+  uint32_t ramExecTime;    //!< time for the controller to execute a RAM write
+  uint32_t longExecTime;   //!< time for the controller to execute clear display and return home
+} LcdTxTiming;
+
+/**
+ * @brief the pins that the LcdTxEngine drives, implemented by whoever owns the pins
+ */
+class LcdTxBus {
+ public:
+  /**
+   * @brief select the register(RS) for the next byte, R/W has to be set to write as well
+   * @param isDataReg true for the RAM, false for instructions
+   */
+  virtual void txRegisterSelect(const bool &isDataReg) = 0;
+
+  /**
+   * @brief put the value for the next strobe on the data pins
+   * @param value a nibble in the low 4 bits in 4 bit mode
+   */
+  virtual void txDataPut(const uint8_t &value) = 0;
+
+  /**
+   * @brief drive the EN pin
+   * @param output true for high
+   */
+  virtual void txEnableSwitch(const bool &output) = 0;
+};
+
+/**
+ * @brief byte waiting in the LcdTxEngine queue
+ */
+typedef struct {
+  uint8_t data;       //!< the byte to send
+  bool    isDataReg;  //!< true if it goes to the RAM, false if it's an instruction
+} LcdTxItem;
+
+/**
+ * @brief where the LcdTxEngine is in sending a byte
+ */
+enum LcdTxState : uint32_t {
+  TX_STATE_IDLE,         //!< nothing to send
+  TX_STATE_SETUP,        //!< take the next byte, set RS and the first nibble
+  TX_STATE_ENABLE_HIGH,  //!< raise EN
+  TX_STATE_ENABLE_LOW    //!< drop EN, the controller latches the nibble
+};
+
+/**
+ * @brief ring buffer of bytes plus the state machine sending them
+ * The caller pushes bytes then calls start(), after that tick() has to be called each time the
+ * delay it returned runs out, usually from a one shot timer interrupt. Only one context may push
+ * and only one may tick.
+ */
+class LcdTxEngine {
+ private:
+  LcdTxBus *  _bus;
+  LcdTxTiming _timing;
+  uint32_t    _strobePerByte;
+
+  LcdTxItem         _queue[LCD_TX_QUEUE_LEN];
+  volatile uint32_t _queueHead;  //!< next item to send, only changed by tick()
+  volatile uint32_t _queueTail;  //!< next free slot, only changed by itemPush()
+  volatile bool     _isRunning;
+
+  LcdTxState _state;
+  LcdTxItem  _currItem;
+  uint32_t   _strobeIndex;
+
+  LcdTxCallback _idleCallback;
+  void *        _idleCallbackContext;
+
+  /**
+   * @brief part of the current byte sent by the current strobe
+   */
+  uint8_t strobeValueGet(void);
+
+  /**
+   * @brief how long the controller takes to execute a byte
+   */
+  uint32_t execTimeGet(const LcdTxItem &item);
+
+ public:
+  /**
+   * @brief Construct a new Lcd Tx Engine object
+   * @param bus the pins to drive
+   */
+  LcdTxEngine(LcdTxBus *bus);
+
+  /**
+   * @brief set timing and bus width, only call while idle
+   * @param timing the timing to use
+   * @param strobePerByte 2 for 4 bit mode, 1 for 8 bit mode
+   */
+  void configure(const LcdTxTiming &timing, const uint32_t &strobePerByte);
+
+  /**
+   * @brief change the pins to drive, only call while idle
+   */
+  void busSet(LcdTxBus *bus);
+
+  /**
+   * @brief add a byte to the queue
+   * @param data the byte to send
+   * @param isDataReg true if it goes to the RAM, false if it's an instruction
+   * @return false if the queue is full and the byte was not added
+   */
+  bool itemPush(const uint8_t &data, const bool &isDataReg);
+
+  /**
+   * @brief start sending if idle and something is queued, the tick() source must be disabled
+   * while calling this
+   * @return true if the engine just started, the caller has to schedule the first tick()
+   */
+  bool start(void);
+
+  /**
+   * @brief do the next step of the state machine
+   * @return uint32_t nanosec until tick() has to be called again, 0 if the queue is done and the
+   * engine went idle
+   */
+  uint32_t tick(void);
+
+  /**
+   * @brief check whether the next tick() starts a new byte
+   */
+  bool isAtByteStart(void) { return TX_STATE_SETUP == _state; }
+
+  /**
+   * @brief peek at the next byte to be sent
+   * @param totalTime set to the nanosec that sending and executing it takes
+   * @param totalStep set to how many tick() it takes
+   * @return false if nothing is queued
+   */
+  bool nextItemTimeGet(uint32_t &totalTime, uint32_t &totalStep);
+
+  /**
+   * @brief check whether every queued byte has been sent and executed by the controller
+   */
+  bool isIdle(void) { return !_isRunning && (_queueHead == _queueTail); }
+
+  /**
+   * @brief set the function called from tick() once the queue is done, nullptr to remove it
+   */
+  void idleCallbackSet(LcdTxCallback callback, void *context);
+};
+
+}  // namespace lcddriver
+
+#endif
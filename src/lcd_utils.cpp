@@ -12,14 +12,19 @@
 #include <cassert>
 #include <cctype>
 #include <cstdint>
+#include <cstring>
 
 // peripheral
 #include "driverlib/gpio.h"
+#include "driverlib/interrupt.h"
 #include "driverlib/pin_map.h"
 #include "driverlib/rom.h"
 #include "driverlib/sysctl.h"
+#include "driverlib/timer.h"
+#include "driverlib/udma.h"
 
 // hardware
+#include "inc/hw_gpio.h"
 #include "inc/hw_ints.h"
 #include "inc/hw_memmap.h"
 #include "inc/hw_types.h"
@@ -27,6 +32,7 @@
 // application
 #include "general_timer/general_timer.hpp"
 #include "lcd_include.hpp"
+#include "lcd_pin_map.hpp"
 #include "tiva_utils/bit_manipulation.h"
 
 namespace lcddriver {
@@ -37,37 +43,121 @@ void LcdDriver::pinDescCheck(uint32_t pinDesc[PIN_DESCRIPTION_LEN]) {
   const uint32_t portFlag  = pinDesc[PIN_DESC_PORT_INDEX];
   const uint32_t pinFlag   = pinDesc[PIN_DESC_PIN_INDEX];
 
-  assert((clockFlag == SYSCTL_PERIPH_GPIOB) || (clockFlag == SYSCTL_PERIPH_GPIOA) ||
-         (clockFlag == SYSCTL_PERIPH_GPIOC) || (clockFlag == SYSCTL_PERIPH_GPIOD) ||
-         (clockFlag == SYSCTL_PERIPH_GPIOE) || (clockFlag == SYSCTL_PERIPH_GPIOF));
+  assert(lcdPortIsValid(portFlag));
+  assert(lcdPortClockGet(portFlag) == clockFlag);
 
-  assert((portFlag == GPIO_PORTA_BASE) || (portFlag == GPIO_PORTB_BASE) ||
-         (portFlag == GPIO_PORTC_BASE) || (portFlag == GPIO_PORTD_BASE) ||
-         (portFlag == GPIO_PORTE_BASE) || (portFlag == GPIO_PORTF_BASE));
-
-  assert((pinFlag == GPIO_PIN_0) || (pinFlag == GPIO_PIN_1) || (pinFlag == GPIO_PIN_2) ||
-         (pinFlag == GPIO_PIN_5) || (pinFlag == GPIO_PIN_3) || (pinFlag == GPIO_PIN_6) ||
-         (pinFlag == GPIO_PIN_4) || (pinFlag == GPIO_PIN_7));
+  // only one pin per description
+  assert((0 != pinFlag) && (pinFlag <= GPIO_PIN_7) && (0 == (pinFlag & (pinFlag - 1))));
 
   // check for specially allocated pins that should not be used
-  assert(!(GPIO_PIN_0 == pinFlag && GPIO_PORTA_BASE == portFlag) &&
-         !(GPIO_PIN_1 == pinFlag && GPIO_PORTA_BASE == portFlag) &&
-         !(GPIO_PIN_5 == pinFlag && GPIO_PORTA_BASE == portFlag) &&
-         !(GPIO_PIN_4 == pinFlag && GPIO_PORTA_BASE == portFlag) &&
-         !(GPIO_PIN_3 == pinFlag && GPIO_PORTA_BASE == portFlag) &&
-         !(GPIO_PIN_2 == pinFlag && GPIO_PORTA_BASE == portFlag) &&
+  assert(!lcdPinIsReserved(portFlag, pinFlag));
+}
 
-         !(GPIO_PIN_3 == pinFlag && GPIO_PORTB_BASE == portFlag) &&
-         !(GPIO_PIN_2 == pinFlag && GPIO_PORTB_BASE == portFlag) &&
+void LcdDriver::geometryCheck(void) {
+  const LcdGeometry& geometry = _lcdConfig.geometry;
+  const uint32_t     lineLen  = LCD_DDRAM_LINE_LEN(geometry.isTwoLineMode);
+  assert((0 < geometry.totalRow) && (geometry.totalRow <= LCD_MAX_TOTAL_ROW));
+  assert((0 < geometry.totalColumn) && (geometry.totalColumn <= LCD_MAX_TOTAL_COLUMN));
+
+  // every row has to stay inside one DDRAM line
+  for (uint32_t row = 0; row < geometry.totalRow; ++row) {
+    const uint32_t lineBegin = (geometry.rowAddrList[row] < 0x40) ? 0 : 0x40;
+    assert(geometry.isTwoLineMode || (0 == lineBegin));
+    assert(geometry.rowAddrList[row] + geometry.totalColumn <= lineBegin + lineLen);
+    assert(geometry.rowControllerList[row] < _lcdConfig.totalController);
+    // a display of a broadcast has a single controller
+    assert(!_lcdConfig.isBroadcast || (0 == geometry.rowControllerList[row]));
+  }
+}
 
-         !(GPIO_PIN_3 == pinFlag && GPIO_PORTC_BASE == portFlag) &&
-         !(GPIO_PIN_2 == pinFlag && GPIO_PORTC_BASE == portFlag) &&
-         !(GPIO_PIN_1 == pinFlag && GPIO_PORTC_BASE == portFlag) &&
-         !(GPIO_PIN_0 == pinFlag && GPIO_PORTC_BASE == portFlag) &&
+void LcdDriver::controllerSelect(const uint32_t& enableMask) {
+  assert((0 != enableMask) && (0 == (enableMask >> _lcdConfig.totalController)));
+  if (enableMask == _enableMask) { return; }
+
+  for (uint32_t controller = 0; controller < _lcdConfig.totalController; ++controller) {
+    if (!bit_get(_enableMask, BIT(controller))) { continue; }
+    LcdControllerState& prevState = _controllerStateList[controller];
+    prevState.isBusyCheckPending  = _isBusyCheckPending;
+    prevState.execStartStamp      = _execStartStamp;
+    prevState.execTime            = _execTime;
+    prevState.addrCounter         = _addrCounter;
+    prevState.isAddrCounterKnown  = _isAddrCounterKnown;
+  }
 
-         !(GPIO_PIN_7 == pinFlag && GPIO_PORTD_BASE == portFlag) &&
+  bool isFirst = true;
+  for (uint32_t controller = 0; controller < _lcdConfig.totalController; ++controller) {
+    if (!bit_get(enableMask, BIT(controller))) { continue; }
+    const LcdControllerState& state = _controllerStateList[controller];
+    if (isFirst) {
+      _isBusyCheckPending = state.isBusyCheckPending;
+      _execStartStamp     = state.execStartStamp;
+      _execTime           = state.execTime;
+      _addrCounter        = state.addrCounter;
+      _isAddrCounterKnown = state.isAddrCounterKnown;
+      isFirst             = false;
+      continue;
+    }
 
-         !(GPIO_PIN_0 == pinFlag && GPIO_PORTF_BASE == portFlag));
+    _isBusyCheckPending = _isBusyCheckPending || state.isBusyCheckPending;
+    if (execLeftGet(state.execStartStamp, state.execTime) >
+        execLeftGet(_execStartStamp, _execTime)) {
+      _execStartStamp = state.execStartStamp;
+      _execTime       = state.execTime;
+    }
+    _isAddrCounterKnown =
+        _isAddrCounterKnown && state.isAddrCounterKnown && (state.addrCounter == _addrCounter);
+  }
+  _enableMask = enableMask;
+  enablePortCreate();
+}
+
+void LcdDriver::enablePortCreate(void) {
+  _totalEnablePort = 0;
+  for (uint32_t controller = 0; controller < _lcdConfig.totalController; ++controller) {
+    if (!bit_get(_enableMask, BIT(controller))) { continue; }
+    const uint32_t portBase = _lcdConfig.enablePinList[controller][PIN_DESC_PORT_INDEX];
+    const uint8_t  pinMask  = _lcdConfig.enablePinList[controller][PIN_DESC_PIN_INDEX];
+
+    uint32_t portIndex = 0;
+    while ((portIndex < _totalEnablePort) && (_enablePortList[portIndex].portBase != portBase)) {
+      ++portIndex;
+    }
+    if (portIndex == _totalEnablePort) {
+      _enablePortList[portIndex].portBase = portBase;
+      _enablePortList[portIndex].pinMask  = 0;
+      ++_totalEnablePort;
+    }
+    bit_set(_enablePortList[portIndex].pinMask, pinMask);
+  }
+}
+
+uint32_t LcdDriver::panelMaskGet(const uint32_t& controller) {
+  // every picked display shows the whole geometry
+  return _lcdConfig.isBroadcast ? _displayMask : BIT(controller);
+}
+
+uint32_t LcdDriver::execLeftGet(const uint64_t& execStartStamp, const uint32_t& execTime) {
+  if (0 == execTime) { return 0; }
+  const uint64_t elapsedTime = _generalTimer.stopTimer(execStartStamp);
+  return (elapsedTime < execTime) ? (execTime - elapsedTime) : 0;
+}
+
+void LcdDriver::controllerAllWrite(const uint8_t*  dataList,
+                                   const uint32_t& dataLen,
+                                   const bool&     isDataReg) {
+  // identical displays take as long to execute a byte so they can share the strobe
+  if ((1 == _lcdConfig.totalController) || _lcdConfig.isBroadcast) {
+    controllerSelect(BIT(_lcdConfig.totalController) - 1);
+    parallelDataWrite(dataList, dataLen, isDataReg);
+    return;
+  }
+
+  for (uint32_t dataIndex = 0; dataIndex < dataLen; ++dataIndex) {
+    for (uint32_t controller = 0; controller < _lcdConfig.totalController; ++controller) {
+      controllerSelect(BIT(controller));
+      parallelDataWriteSingle(dataList[dataIndex], isDataReg);
+    }
+  }
 }
 
 void LcdDriver::pinModeSwitch(const uint32_t pinDesc[PIN_DESCRIPTION_LEN], const bool& isInput) {
@@ -78,7 +168,11 @@ void LcdDriver::pinModeSwitch(const uint32_t pinDesc[PIN_DESCRIPTION_LEN], const
   }
 }
 
-void LcdDriver::pinWrite(const uint32_t pinDesc[PIN_DESCRIPTION_LEN], const bool& output) {
+void LcdDriver::pinWrite(const uint32_t        pinDesc[PIN_DESCRIPTION_LEN],
+                         const bool&           output,
+                         const LcdTraceSignal& traceSignal) {
+  LCD_INSTRUMENT_SCOPE(INSTRUMENT_PIN_WRITE);
+  LCD_TRACE_PIN(traceSignal, output);
   uint8_t pinOutput = output ? pinDesc[PIN_DESC_PIN_INDEX] : 0;
   GPIOPinWrite(pinDesc[PIN_DESC_PORT_INDEX], pinDesc[PIN_DESC_PIN_INDEX], pinOutput);
 }
@@ -95,6 +189,202 @@ void LcdDriver::pinPadConfig(const uint32_t pinDesc[PIN_DESCRIPTION_LEN]) {
                    GPIO_PIN_TYPE_STD);
 }
 
+/* Async transmit */
+
+// the driver served by LcdTxTimerIntHandler
+static LcdDriver* txTimerDriver = nullptr;
+
+static const uint32_t DMA_CHANNEL_NUM = LCD_DMA_CHANNEL & 0xff;
+
+#ifdef LCD_DMA_STREAM
+// uDMA control table has to be 1024 byte aligned, only the timer channel is used
+#if defined(ccs)
+#pragma DATA_ALIGN(1024)
+static tDMAControlTable dmaControlTable[64];
+#else
+static tDMAControlTable dmaControlTable[64] __attribute__((aligned(1024)));
+#endif
+
+static const uint32_t   DMA_MAX_TASK = LCD_DMA_WAVEFORM_LEN / LCD_DMA_MAX_TRANSFER + 1;
+static tDMAControlTable dmaTaskList[DMA_MAX_TASK];
+static uint8_t          dmaWaveform[LCD_DMA_WAVEFORM_LEN];
+#endif
+
+void LcdDriver::txTimerInit(void) {
+  assert(nullptr == txTimerDriver);
+  txTimerDriver = this;
+
+  SysCtlPeripheralEnable(LCD_TX_TIMER_CLOCK);
+  while (!SysCtlPeripheralReady(LCD_TX_TIMER_CLOCK)) {
+    // wait for clock to be ready
+  }
+  _txTickPerMicrosec = SysCtlClockGet() / 1000000;
+
+  if (_lcdConfig.isDmaStreamed) {
+    // the timer paces the uDMA, the uDMA done interrupt comes through the timer interrupt
+    TimerConfigure(LCD_TX_TIMER_BASE, TIMER_CFG_PERIODIC);
+    TimerLoadSet(LCD_TX_TIMER_BASE, TIMER_A, LCD_DMA_SLOT_NANOSEC * _txTickPerMicrosec / 1000 - 1);
+    TimerIntEnable(LCD_TX_TIMER_BASE, TIMER_TIMA_DMA);
+    dmaInit();
+  } else {
+    TimerConfigure(LCD_TX_TIMER_BASE, TIMER_CFG_ONE_SHOT);
+    TimerIntEnable(LCD_TX_TIMER_BASE, TIMER_TIMA_TIMEOUT);
+  }
+  IntEnable(LCD_TX_TIMER_INT);
+}
+
+void LcdDriver::txTimerDeinit(void) {
+  if (this != txTimerDriver) { return; }
+  IntDisable(LCD_TX_TIMER_INT);
+  TimerDisable(LCD_TX_TIMER_BASE, TIMER_A);
+  txTimerDriver = nullptr;
+}
+
+void LcdDriver::txTimerArm(const uint32_t& delay) {
+  TimerLoadSet(LCD_TX_TIMER_BASE, TIMER_A, ((uint64_t)delay * _txTickPerMicrosec) / 1000 + 1);
+  TimerEnable(LCD_TX_TIMER_BASE, TIMER_A);
+}
+
+void LcdDriver::txStart(void) {
+  // the interrupt may be finishing the queue at the same time
+  IntDisable(LCD_TX_TIMER_INT);
+  if (_lcdConfig.isDmaStreamed) {
+    // a stream that is playing picks up the new bytes when it's done
+    if (!_isDmaBusy) { dmaStart(); }
+  } else if (_txEngine.start()) {
+    txTimerArm(0);
+  }
+  IntEnable(LCD_TX_TIMER_INT);
+}
+
+#ifdef LCD_DMA_STREAM
+void LcdDriver::dmaInit(void) {
+  // uDMA can only write to one port so every signal has to be there, which leaves room for only 4
+  // data pins
+  const uint32_t portBase = _lcdConfig.regSelectPin[PIN_DESC_PORT_INDEX];
+  assert(!_lcdConfig.is8BitBus);
+  assert(1 == _totalDataPort);
+  assert(_dataPortList[0].portBase == portBase);
+  assert(_lcdConfig.isWriteOnly || (_lcdConfig.readWritePin[PIN_DESC_PORT_INDEX] == portBase));
+  assert(_lcdConfig.enablePinList[0][PIN_DESC_PORT_INDEX] == portBase);
+
+  LcdWaveformPinMap pinMap;
+  pinMap.regSelectPin = _lcdConfig.regSelectPin[PIN_DESC_PIN_INDEX];
+  pinMap.readWritePin = _lcdConfig.isWriteOnly ? 0 : _lcdConfig.readWritePin[PIN_DESC_PIN_INDEX];
+  pinMap.enablePin    = _lcdConfig.enablePinList[0][PIN_DESC_PIN_INDEX];
+  memcpy(pinMap.nibbleOutput, _dataPortList[0].nibbleOutput, sizeof(pinMap.nibbleOutput));
+  _waveform.configure(pinMap, LCD_DMA_SLOT_NANOSEC, dmaWaveform, LCD_DMA_WAVEFORM_LEN);
+  _txEngine.busSet(&_waveform);
+
+  SysCtlPeripheralEnable(SYSCTL_PERIPH_UDMA);
+  while (!SysCtlPeripheralReady(SYSCTL_PERIPH_UDMA)) {
+    // wait for clock to be ready
+  }
+  uDMAEnable();
+  uDMAControlBaseSet(dmaControlTable);
+  uDMAChannelAssign(LCD_DMA_CHANNEL);
+  uDMAChannelAttributeDisable(DMA_CHANNEL_NUM, UDMA_ATTR_ALL);
+}
+
+void LcdDriver::dmaStart(void) {
+  _txEngine.start();
+  const uint32_t waveformLen = _waveform.record(_txEngine);
+  if (0 == waveformLen) {
+    _isDmaBusy = false;
+    if (_dmaIdleCallback) { _dmaIdleCallback(_dmaIdleCallbackContext); }
+    return;
+  }
+  _isDmaBusy = true;
+
+  // a read may have left the data pins as input
+  parallelModeSwitch(false);
+
+  // the masked data register only lets the lcd pins change
+  const uint32_t portDataAddr = _lcdConfig.regSelectPin[PIN_DESC_PORT_INDEX] + GPIO_O_DATA +
+                                (_waveform.pinMaskGet() << 2);
+
+  uint32_t totalTask = 0;
+  for (uint32_t offset = 0; offset < waveformLen; offset += LCD_DMA_MAX_TRANSFER) {
+    const uint32_t taskLen    = ((waveformLen - offset) < LCD_DMA_MAX_TRANSFER)
+                                    ? (waveformLen - offset)
+                                    : LCD_DMA_MAX_TRANSFER;
+    const bool     isLastTask = (offset + taskLen) == waveformLen;
+
+    const tDMAControlTable task = uDMATaskStructEntry(
+        taskLen,
+        UDMA_SIZE_8,
+        UDMA_SRC_INC_8,
+        dmaWaveform + offset,
+        UDMA_DST_INC_NONE,
+        (void*)(uintptr_t)portDataAddr,
+        UDMA_ARB_1,
+        isLastTask ? UDMA_MODE_BASIC : UDMA_MODE_PER_SCATTER_GATHER);
+    dmaTaskList[totalTask].pvSrcEndAddr = task.pvSrcEndAddr;
+    dmaTaskList[totalTask].pvDstEndAddr = task.pvDstEndAddr;
+    dmaTaskList[totalTask].ui32Control  = task.ui32Control;
+    ++totalTask;
+  }
+
+  uDMAChannelScatterGatherSet(DMA_CHANNEL_NUM, totalTask, dmaTaskList, 1);
+  uDMAChannelEnable(DMA_CHANNEL_NUM);
+  TimerEnable(LCD_TX_TIMER_BASE, TIMER_A);
+}
+#else
+void LcdDriver::dmaInit(void) {
+  // the uDMA buffers take RAM so they're only there when asked for
+  assert(0 && "LcdConfig::isDmaStreamed needs LCD_DMA_STREAM");
+}
+
+void LcdDriver::dmaStart(void) {}
+#endif
+
+void LcdDriver::txQueuePush(const uint8_t*  dataList,
+                            const uint32_t& dataLen,
+                            const bool&     isDataReg) {
+  // a synchronous read may have left an instruction executing
+  if (_txEngine.isIdle()) { busyWait(); }
+
+  for (uint32_t dataIndex = 0; dataIndex < dataLen; ++dataIndex) {
+    while (!_txEngine.itemPush(dataList[dataIndex], isDataReg)) {
+      txStart();
+      SysCtlDelay(LCD_TX_POLL_DELAY_LOOP);
+    }
+  }
+  txStart();
+}
+
+void LcdDriver::txTimerIsr(void) {
+  if (_lcdConfig.isDmaStreamed) {
+    // only the uDMA done interrupt is enabled, the timer itself keeps triggering the uDMA, the last
+    // task runs from the alternate structure so that one stops last
+    TimerIntClear(LCD_TX_TIMER_BASE, TIMER_TIMA_DMA);
+    if (UDMA_MODE_STOP != uDMAChannelModeGet(DMA_CHANNEL_NUM | UDMA_ALT_SELECT)) { return; }
+    uDMAIntClear(1 << DMA_CHANNEL_NUM);
+    TimerDisable(LCD_TX_TIMER_BASE, TIMER_A);
+    dmaStart();
+    return;
+  }
+
+  TimerIntClear(LCD_TX_TIMER_BASE, TIMER_TIMA_TIMEOUT);
+
+  uint32_t nextTickTime = _txEngine.tick();
+  while ((0 != nextTickTime) && (nextTickTime < LCD_TX_MIN_TIMER_NANOSEC)) {
+    _generalTimer.wait(nextTickTime);
+    nextTickTime = _txEngine.tick();
+  }
+  if (0 != nextTickTime) { txTimerArm(nextTickTime); }
+}
+
+void LcdDriver::txRegisterSelect(const bool& isDataReg) {
+  parallelModeSwitch(false);
+  registerSelect(isDataReg);
+  comModeSwitch(false);
+}
+
+void LcdDriver::txDataPut(const uint8_t& value) { dataPinWrite(value); }
+
+void LcdDriver::txEnableSwitch(const bool& output) { comSwitch(output); }
+
 /* command helper */
 uint8_t LcdDriver::entryModeCommandCreate(const bool& cursorRightDir,
                                           const bool& displayShiftEnabled) {
@@ -135,19 +425,106 @@ uint8_t LcdDriver::cursorDisplayShiftCommandCreate(const bool& isShiftDisplay,
 }
 
 /* Parallel Stuff */
+void LcdDriver::dataPortCreate(void) {
+  _totalDataPort = 0;
+  for (uint32_t pin = 0; pin < _totalParallelPin; ++pin) {
+    const uint32_t portBase = _lcdConfig.parallelPinList[pin][PIN_DESC_PORT_INDEX];
+    const uint8_t  pinMask  = _lcdConfig.parallelPinList[pin][PIN_DESC_PIN_INDEX];
+
+    uint32_t portIndex = 0;
+    while ((portIndex < _totalDataPort) && (_dataPortList[portIndex].portBase != portBase)) {
+      ++portIndex;
+    }
+    if (portIndex == _totalDataPort) {
+      _dataPortList[portIndex].portBase = portBase;
+      _dataPortList[portIndex].pinMask  = 0;
+      memset(_dataPortList[portIndex].nibbleOutput, 0, 16);
+      memset(_dataPortList[portIndex].lowNibbleOutput, 0, 16);
+      ++_totalDataPort;
+    }
+
+    // with a 4 bit bus the pins are D4-D7
+    const uint32_t dataBit      = pin + 8 - _totalParallelPin;
+    LcdDataPort&   dataPort     = _dataPortList[portIndex];
+    uint8_t*       nibbleOutput = (dataBit < 4) ? dataPort.lowNibbleOutput : dataPort.nibbleOutput;
+    bit_set(dataPort.pinMask, pinMask);
+    for (uint8_t nibble = 0; nibble < 16; ++nibble) {
+      if (bit_get(nibble, BIT(dataBit & 0x3))) { bit_set(nibbleOutput[nibble], pinMask); }
+    }
+  }
+}
+
+void LcdDriver::dataPinWrite(const uint8_t& value) {
+  const uint8_t highNibble = (_lcdConfig.is8BitBus ? (value >> 4) : value) & 0xf;
+  const uint8_t lowNibble  = value & 0xf;
+  for (uint32_t port = 0; port < _totalDataPort; ++port) {
+    const LcdDataPort& dataPort = _dataPortList[port];
+    GPIOPinWrite(dataPort.portBase,
+                 dataPort.pinMask,
+                 dataPort.nibbleOutput[highNibble] | dataPort.lowNibbleOutput[lowNibble]);
+  }
+#ifdef LCD_TRACE
+  for (uint32_t pin = 0; pin < _totalParallelPin; ++pin) {
+    LCD_TRACE_PIN(lcdTraceDataSignalGet(pin + 8 - _totalParallelPin), (value >> pin) & 1);
+  }
+#endif
+}
+
+uint8_t LcdDriver::dataPinRead(void) {
+  uint8_t portInput[TOTAL_PARALLEL_PIN];
+  for (uint32_t port = 0; port < _totalDataPort; ++port) {
+    portInput[port] = GPIOPinRead(_dataPortList[port].portBase, _dataPortList[port].pinMask);
+  }
+
+  uint8_t value = 0;
+  for (uint32_t pin = 0; pin < _totalParallelPin; ++pin) {
+    for (uint32_t port = 0; port < _totalDataPort; ++port) {
+      if ((_dataPortList[port].portBase == _lcdConfig.parallelPinList[pin][PIN_DESC_PORT_INDEX]) &&
+          bit_get(portInput[port], _lcdConfig.parallelPinList[pin][PIN_DESC_PIN_INDEX])) {
+        bit_set(value, BIT(pin));
+      }
+    }
+  }
+  return value;
+}
+
 void LcdDriver::parallelModeSwitch(const bool& isInput) {
-  for (uint32_t pin = 0; pin < TOTAL_PARALLEL_PIN; ++pin) {
-    pinModeSwitch(_lcdConfig.parallelPinList[pin], isInput);
+  LCD_INSTRUMENT_SCOPE(INSTRUMENT_PARALLEL_MODE_SWITCH);
+  if (isInput == _isParallelInput) { return; }
+
+  // pins sharing a port change direction together
+  for (uint32_t port = 0; port < _totalDataPort; ++port) {
+    GPIODirModeSet(_dataPortList[port].portBase,
+                   _dataPortList[port].pinMask,
+                   isInput ? GPIO_DIR_MODE_IN : GPIO_DIR_MODE_OUT);
   }
+  _isParallelInput = isInput;
+#ifdef LCD_TRACE
+  // going back to output shows as floating until the next nibble is written, always b4 EN rises
+  if (isInput) {
+    for (uint32_t pin = 0; pin < _totalParallelPin; ++pin) {
+      LCD_TRACE_PIN(lcdTraceDataSignalGet(pin + 8 - _totalParallelPin), LCD_TRACE_LEVEL_FLOAT);
+    }
+  }
+#endif
 }
 
 void LcdDriver::parallelDataWriteSingle(const uint8_t& data, const bool& isDataReg) {
+  if (_isAsyncActive) {
+    txQueuePush(&data, 1, isDataReg);
+    return;
+  }
+
+  busyWait();
   parallelModeSwitch(false);
   comSetup(isDataReg, false);
+  byteStrobe(data);
+  execPendingSet(data, isDataReg);
+}
+
+void LcdDriver::byteStrobe(const uint8_t& data) {
   for (int32_t bitIndex = _totalBitPerPin - 1; bitIndex != -1; --bitIndex) {
-    for (uint32_t pin = 0; pin < TOTAL_PARALLEL_PIN; ++pin) {
-      pinWrite(_lcdConfig.parallelPinList[pin], bit_get(data >> 4 * bitIndex, BIT(pin)));
-    }
+    dataPinWrite(data >> 4 * bitIndex);
     if (0 != bitIndex) { comMaintain(false); }
   }
   comStop();
@@ -156,24 +533,45 @@ void LcdDriver::parallelDataWriteSingle(const uint8_t& data, const bool& isDataR
 void LcdDriver::parallelDataWrite(const uint8_t*  dataList,
                                   const uint32_t& dataLen,
                                   const bool&     isDataReg) {
+  if (_isAsyncActive) {
+    txQueuePush(dataList, dataLen, isDataReg);
+    return;
+  }
+
+  // the busy flag is read between bytes, which needs R/W and the bus direction of its own
+  if (PACING_BUSY_FLAG == _lcdConfig.pacingMode) {
+    for (uint32_t dataIndex = 0; dataIndex < dataLen; ++dataIndex) {
+      parallelDataWriteSingle(dataList[dataIndex], isDataReg);
+    }
+    return;
+  }
+
+  // RS, R/W and the bus direction stay set up for the whole run, each byte only waits for what is
+  // left of the execution time of the one b4 it
+  busyWait();
   parallelModeSwitch(false);
   comSetup(isDataReg, false);
-
   for (uint32_t dataIndex = 0; dataIndex < dataLen; ++dataIndex) {
-    for (int32_t bitIndex = _totalBitPerPin - 1; bitIndex != -1; --bitIndex) {
-      for (uint32_t pin = 0; pin < TOTAL_PARALLEL_PIN; ++pin) {
-        pinWrite(_lcdConfig.parallelPinList[pin],
-                 bit_get(dataList[dataIndex] >> 4 * bitIndex, BIT(pin)));
-      }
-      if ((0 != bitIndex) || ((dataLen - 1) != dataIndex)) { comMaintain(false); }
+    if (0 != dataIndex) {
+      busyWait();
+      comResume();
     }
+    byteStrobe(dataList[dataIndex]);
+    execPendingSet(dataList[dataIndex], isDataReg);
   }
-  comStop();
 }
 
 void LcdDriver::parallelDataRead(const bool&     isDataReg,
                                  uint8_t*        readDataBuf,
                                  const uint32_t& totalReadData) {
+  assert(!_lcdConfig.isWriteOnly);
+  // only one controller can drive the data pins
+  assert(0 == (_enableMask & (_enableMask - 1)));
+  // reads are never queued, everything b4 them has to be done first
+  flush();
+
+  // the busy flag itself can always be read, RAM can only be read once the controller is idle
+  if (isDataReg) { busyWait(); }
   parallelModeSwitch(true);
   comSetup(isDataReg, true);
 
@@ -183,24 +581,19 @@ void LcdDriver::parallelDataRead(const bool&     isDataReg,
 
   for (uint32_t dataIndex = 0; dataIndex < totalReadData; ++dataIndex) {
     for (int32_t bitIndex = _totalBitPerPin - 1; bitIndex != -1; --bitIndex) {
-      for (uint32_t pin = 0; pin < TOTAL_PARALLEL_PIN; ++pin) {
-        if (pinRead(_lcdConfig.parallelPinList[pin])) {
-          bit_set(readDataBuf[dataIndex], BIT(pin + (4 * bitIndex)));
-        }
-      }
+      bit_set(readDataBuf[dataIndex], dataPinRead() << (4 * bitIndex));
       if (0 != bitIndex || ((totalReadData - 1) != dataIndex)) { comMaintain(true); }
     }
   }
 
   comStop();
+  // reading RAM moves the address counter which takes an instruction cycle
+  if (isDataReg) { execPendingSet(0, true); }
 }
 
-void LcdDriver::dataWrite4Bit(const uint32_t& dataToWrite, const bool& stopAfterWrite) {
+void LcdDriver::singleStrobeWrite(const uint32_t& dataToWrite, const bool& stopAfterWrite) {
   comSetup(false, false);
-  for (uint32_t pin = 0; pin < TOTAL_PARALLEL_PIN; ++pin) {
-    pinWrite(_lcdConfig.parallelPinList[pin],
-             bit_get(dataToWrite >> ((4 == TOTAL_PARALLEL_PIN) ? 4 : 0), BIT(pin)));
-  }
+  dataPinWrite(dataToWrite >> (_lcdConfig.is8BitBus ? 0 : 4));
   if (stopAfterWrite) {
     comStop();
   } else {
@@ -210,6 +603,17 @@ void LcdDriver::dataWrite4Bit(const uint32_t& dataToWrite, const bool& stopAfter
 
 void LcdDriver::addrCounterChange(const uint8_t& addr, const bool& isDataRam) {
   parallelDataWriteSingle(addr | (isDataRam ? BIT(7) : BIT(6)), false);
+  _addrCounter        = addr;
+  _isAddrCounterKnown = isDataRam;
+}
+
+void LcdDriver::addrCounterSync(void) {
+  controllerSelect(panelMaskGet(_lcdConfig.geometry.rowControllerList[_cursorY]));
+  if (_cursorX >= _lcdConfig.geometry.totalColumn) { return; }
+  const uint8_t cursorAddr = _lcdConfig.geometry.rowAddrList[_cursorY] + _cursorX;
+  if (!_isAddrCounterKnown || (cursorAddr != _addrCounter)) {
+    addrCounterChange(cursorAddr, true);
+  }
 }
 
 /* RAM stuffs */
@@ -225,37 +629,231 @@ void LcdDriver::ramDataRead(uint8_t*        returnData,
   addrCounterChange(startingRamAddr, isDataRam);
 
   parallelDataRead(true, returnData, totalDataRead);
+  // reading moves the address counter
+  _isAddrCounterKnown = false;
+}
+
+/**
+ * @brief what a character of a string in text mode turns into
+ */
+enum TextCharType { TEXT_CHAR_PRINT, TEXT_CHAR_NEWLINE, TEXT_CHAR_SKIP };
+
+/**
+ * @brief decode the character at strIndex of a string in text mode, it can be a normal character, a
+ * newline, whitespace that is not printed or a custom character pattern
+ *
+ * @param data the string
+ * @param dataLen len of the string
+ * @param strIndex index of the character to decode, moved past the escape sequence if there is one
+ * @param printChar the character to send to the DDRAM if TEXT_CHAR_PRINT is returned
+ * @return TextCharType how the character should be handled
+ */
+static TextCharType textCharDecode(const uint8_t*  data,
+                                   const uint32_t& dataLen,
+                                   uint32_t&       strIndex,
+                                   uint8_t&        printChar) {
+  printChar = data[strIndex];
+  if (isspace(data[strIndex])) {
+    if (0x0a == data[strIndex]) { return TEXT_CHAR_NEWLINE; }
+    return (0x20 == data[strIndex]) ? TEXT_CHAR_PRINT : TEXT_CHAR_SKIP;
+  }
+
+  // parse special character
+  if (('`' == data[strIndex]) && (strIndex < dataLen - 1) && isdigit(data[strIndex + 1]) &&
+      ((uint32_t)(data[strIndex + 1] - '0') < MAX_TOTAL_CUSTOM_PATTERN)) {
+    printChar = data[strIndex + 1] - '0';
+    ++strIndex;
+  }
+  return TEXT_CHAR_PRINT;
 }
 
 void LcdDriver::ramDataWrite(const uint8_t* data, const uint32_t dataLen, const bool& isTextMode) {
   assert(data);
   assert(dataLen > 0);
 
+  if (!isTextMode) {
+    parallelDataWrite(data, dataLen, true);
+    return;
+  }
+
+  assert(dataLen <= LCD_MAX_PRINT_STRING);
+  addrCounterSync();
+
+  // printable characters are gathered into runs, with fixed delay pacing each run goes out in one
+  // transaction with RS high
+  const LcdGeometry& geometry = _lcdConfig.geometry;
+  uint8_t            runData[LCD_MAX_PRINT_STRING];
+  uint32_t           runLen = 0;
   for (uint32_t strIndex = 0; strIndex < dataLen; ++strIndex) {
-    if (isTextMode) {
-      if (isspace(data[strIndex])) {
-        if (0x0a == data[strIndex]) {
-          // newline case
-          parallelDataWriteSingle(LCD_JUMP_LINE_COMMAND, false);
-        } else if (0x20 == data[strIndex]) {
-          parallelDataWriteSingle(data[strIndex], true);
+    uint8_t printChar = 0;
+    switch (textCharDecode(data, dataLen, strIndex, printChar)) {
+      case TEXT_CHAR_NEWLINE:
+        if (runLen > 0) { parallelDataWrite(runData, runLen, true); }
+        runLen   = 0;
+        _cursorX = 0;
+        if (_cursorY + 1 < geometry.totalRow) { ++_cursorY; }
+        addrCounterSync();
+        break;
+
+      case TEXT_CHAR_PRINT:
+        // the rows of a 4 row panel aren't next to each other in the DDRAM so a full row always
+        // ends the run, past the last row there's nowhere to go
+        if (_cursorX >= geometry.totalColumn) {
+          if (_cursorY + 1 >= geometry.totalRow) { break; }
+          if (runLen > 0) { parallelDataWrite(runData, runLen, true); }
+          runLen   = 0;
+          _cursorX = 0;
+          ++_cursorY;
+          addrCounterSync();
+        }
+        runData[runLen++] = printChar;
+        shadowWrite(_cursorY, _cursorX, &printChar, 1);
+        ++_cursorX;
+        ++_addrCounter;
+        break;
+
+      default:
+        break;
+    }
+  }
+  if (runLen > 0) { parallelDataWrite(runData, runLen, true); }
+}
+
+void LcdDriver::shadowClear(void) {
+  memset(_ddramShadow, LCD_SPACE_CHAR, sizeof(_ddramShadow));
+  _cursorX = 0;
+  _cursorY = 0;
+  for (uint32_t controller = 0; controller < _lcdConfig.totalController; ++controller) {
+    controllerSelect(BIT(controller));
+    _addrCounter        = 0;
+    _isAddrCounterKnown = true;
+  }
+}
+
+void LcdDriver::shadowWrite(const uint8_t&  row,
+                            const uint8_t&  column,
+                            const uint8_t*  data,
+                            const uint32_t& dataLen) {
+  for (uint32_t controller = 0; controller < _lcdConfig.totalController; ++controller) {
+    if (bit_get(_enableMask, BIT(controller))) {
+      memcpy(&_ddramShadow[controller][row][column], data, dataLen);
+    }
+  }
+}
+
+bool LcdDriver::shadowIsStale(const uint32_t& shadowMask,
+                              const uint8_t&  row,
+                              const uint8_t&  column,
+                              const uint8_t&  value) {
+  for (uint32_t controller = 0; controller < _lcdConfig.totalController; ++controller) {
+    if (bit_get(shadowMask, BIT(controller)) &&
+        (value != _ddramShadow[controller][row][column])) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void LcdDriver::textRender(uint8_t        frame[LCD_MAX_TOTAL_ROW][LCD_MAX_TOTAL_COLUMN],
+                           const uint8_t* data,
+                           const uint32_t dataLen,
+                           uint8_t&       cursorX,
+                           uint8_t&       cursorY) {
+  const LcdGeometry& geometry = _lcdConfig.geometry;
+  for (uint32_t strIndex = 0; strIndex < dataLen; ++strIndex) {
+    uint8_t printChar = 0;
+    switch (textCharDecode(data, dataLen, strIndex, printChar)) {
+      case TEXT_CHAR_NEWLINE:
+        // same as ramDataWrite
+        cursorX = 0;
+        if (cursorY + 1 < geometry.totalRow) { ++cursorY; }
+        break;
+
+      case TEXT_CHAR_PRINT:
+        if (cursorX >= geometry.totalColumn) {
+          if (cursorY + 1 >= geometry.totalRow) { break; }
+          cursorX = 0;
+          ++cursorY;
+        }
+        frame[cursorY][cursorX] = printChar;
+        ++cursorX;
+        break;
+
+      default:
+        break;
+    }
+  }
+}
+
+void LcdDriver::frameFlush(const uint8_t frame[LCD_MAX_TOTAL_ROW][LCD_MAX_TOTAL_COLUMN]) {
+  const LcdGeometry& geometry = _lcdConfig.geometry;
+  // the displays of a broadcast are written as one controller
+  const uint32_t totalController = _lcdConfig.isBroadcast ? 1 : _lcdConfig.totalController;
+  LcdFrameSpan   spanList[LCD_MAX_CONTROLLER];
+  uint32_t       totalActive = 0;
+  for (uint32_t controller = 0; controller < totalController; ++controller) {
+    spanList[controller].row    = 0;
+    spanList[controller].column = 0;
+    if (frameSpanFind(frame, controller, spanList[controller])) { ++totalActive; }
+  }
+
+  while (0 != totalActive) {
+    for (uint32_t controller = 0; controller < totalController; ++controller) {
+      LcdFrameSpan& span = spanList[controller];
+      if (span.row == geometry.totalRow) { continue; }
+
+      controllerSelect(panelMaskGet(controller));
+      const uint8_t spanAddr = geometry.rowAddrList[span.row] + span.column;
+      if (!_isAddrCounterKnown || (spanAddr != _addrCounter)) { addrCounterChange(spanAddr, true); }
+      // a controller left on its own gets the rest of its span in one go
+      const uint8_t writeLen = (1 == totalActive) ? (span.spanEnd - span.column) : 1;
+      parallelDataWrite(&frame[span.row][span.column], writeLen, true);
+      shadowWrite(span.row, span.column, &frame[span.row][span.column], writeLen);
+      _addrCounter += writeLen;
+      span.column += writeLen;
+      if ((span.column == span.spanEnd) && !frameSpanFind(frame, controller, span)) {
+        --totalActive;
+      }
+    }
+  }
+}
+
+bool LcdDriver::frameSpanFind(const uint8_t   frame[LCD_MAX_TOTAL_ROW][LCD_MAX_TOTAL_COLUMN],
+                              const uint32_t& controller,
+                              LcdFrameSpan&   span) {
+  const LcdGeometry& geometry   = _lcdConfig.geometry;
+  const uint32_t     shadowMask = panelMaskGet(controller);
+  for (; span.row < geometry.totalRow; ++span.row, span.column = 0) {
+    if (controller != geometry.rowControllerList[span.row]) { continue; }
+
+    const uint8_t row = span.row;
+    while (span.column < geometry.totalColumn) {
+      if (!shadowIsStale(shadowMask, row, span.column, frame[row][span.column])) {
+        ++span.column;
+        continue;
+      }
+
+      // extend the span until there are 2 unchanged characters in a row, rewriting one unchanged
+      // character costs the same as a new address change so it's kept in the span
+      span.spanEnd = span.column + 1;
+      for (uint8_t next = span.spanEnd; next < geometry.totalColumn; ++next) {
+        if (shadowIsStale(shadowMask, row, next, frame[row][next])) {
+          span.spanEnd = next + 1;
+        } else if (next - span.spanEnd >= 1) {
+          break;
         }
-        // parse special character
-      } else if (('`' == data[strIndex]) && (strIndex < dataLen - 1) &&
-                 isdigit(data[strIndex + 1]) &&
-                 (data[strIndex + 1] - '0' < MAX_TOTAL_CUSTOM_PATTERN)) {
-        parallelDataWriteSingle(data[strIndex + 1] - '0', true);
-        ++strIndex;
-      } else {
-        parallelDataWriteSingle(data[strIndex], true);
       }
-    } else {
-      parallelDataWriteSingle(data[strIndex], true);
+      return true;
     }
   }
+  return false;
 }
 
 uint8_t LcdDriver::addrCounterGet(void) {
+  if (_lcdConfig.isWriteOnly) {
+    assert(_isAddrCounterKnown);
+    return _addrCounter;
+  }
   return bit_get(instructionDataRead(), LCD_ADDR_COUNTER_MASK);
 }
 
@@ -265,6 +863,15 @@ uint8_t LcdDriver::instructionDataRead(void) {
   return dataBuf[0];
 }
 
-bool LcdDriver::lcdIsBusy(void) { return (bool)bit_get(instructionDataRead(), BIT(LCD_BUSY_BIT)); }
+bool LcdDriver::lcdIsBusy(void) {
+  if (_lcdConfig.isWriteOnly) {
+    return (0 != _execTime) && (_generalTimer.stopTimer(_execStartStamp) < _execTime);
+  }
+  return (bool)bit_get(instructionDataRead(), BIT(LCD_BUSY_BIT));
+}
+
+}  // namespace lcddriver
 
-}  // namespace lcddriver
\ No newline at end of file
+void LcdTxTimerIntHandler(void) {
+  if (lcddriver::txTimerDriver) { lcddriver::txTimerDriver->txTimerIsr(); }
+}
\ No newline at end of file
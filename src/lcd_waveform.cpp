@@ -0,0 +1,99 @@
+/**
+ * @brief Implement LcdWaveform, like LcdTxEngine it doesn't touch any TivaC peripheral
+ *
+ * @file lcd_waveform.cpp
+ * @author Khoi Trinh
+ * @date 2018-09-23
+ */
+
+#include "lcd_waveform.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+
+namespace lcddriver {
+
+LcdWaveform::LcdWaveform()
+    : _pinMap(LcdWaveformPinMap()),
+      _slotTime(1),
+      _buffer(nullptr),
+      _capacity(0),
+      _len(0),
+      _portOutput(0),
+      _heldTime(0) {}
+
+void LcdWaveform::configure(const LcdWaveformPinMap& pinMap,
+                            const uint32_t&          slotTime,
+                            uint8_t*                 buffer,
+                            const uint32_t&          capacity) {
+  assert(slotTime > 0);
+  assert(buffer);
+  _pinMap     = pinMap;
+  _slotTime   = slotTime;
+  _buffer     = buffer;
+  _capacity   = capacity;
+  _portOutput = 0;
+}
+
+uint8_t LcdWaveform::pinMaskGet(void) {
+  return _pinMap.regSelectPin | _pinMap.readWritePin | _pinMap.enablePin |
+         _pinMap.nibbleOutput[0xf];
+}
+
+void LcdWaveform::slotAppend(const uint32_t& delay) {
+  // the output of every step gets at least one slot of its own
+  const uint32_t remainTime = (delay > _heldTime) ? (delay - _heldTime) : 0;
+  const uint32_t totalSlot =
+      (remainTime > _slotTime) ? (remainTime + _slotTime - 1) / _slotTime : 1;
+  assert(_len + totalSlot <= _capacity);
+  memset(_buffer + _len, _portOutput, totalSlot);
+  _len += totalSlot;
+  _heldTime = 0;
+}
+
+uint32_t LcdWaveform::record(LcdTxEngine& engine) {
+  _len = 0;
+  for (;;) {
+    if (engine.isAtByteStart()) {
+      uint32_t totalTime = 0;
+      uint32_t totalStep = 0;
+      // every step may round up by almost a slot and may hold the EN fall for one more
+      if (engine.nextItemTimeGet(totalTime, totalStep) &&
+          (_len + totalTime / _slotTime + 2 * totalStep > _capacity)) {
+        assert(0 != _len && "buffer can't fit a single byte");
+        break;
+      }
+    }
+
+    const uint32_t delay = engine.tick();
+    if (0 == delay) { break; }
+    slotAppend(delay);
+  }
+  return _len;
+}
+
+void LcdWaveform::txRegisterSelect(const bool& isDataReg) {
+  // R/W stays low
+  _portOutput = (_portOutput & _pinMap.enablePin) | (isDataReg ? _pinMap.regSelectPin : 0);
+}
+
+void LcdWaveform::txDataPut(const uint8_t& value) {
+  _portOutput = (_portOutput & ~_pinMap.nibbleOutput[0xf]) | _pinMap.nibbleOutput[value & 0xf];
+}
+
+void LcdWaveform::txEnableSwitch(const bool& output) {
+  if (output) {
+    _portOutput |= _pinMap.enablePin;
+    return;
+  }
+
+  // the controller latches on the EN fall, so the data has to stay for a slot after it instead of
+  // changing in the same port write
+  _portOutput &= ~_pinMap.enablePin;
+  assert(_len < _capacity);
+  _buffer[_len++] = _portOutput;
+  _heldTime       = _slotTime;
+}
+
+}  // namespace lcddriver
@@ -0,0 +1,83 @@
+/**
+ * @brief turns the bytes queued in an LcdTxEngine into a buffer of port values, one per fixed time
+ * slot, so a timer triggered uDMA channel can play them into the GPIO data register
+ *
+ * @file lcd_waveform.hpp
+ * @author Khoi Trinh
+ * @date 2018-09-23
+ */
+
+#ifndef _LCD_WAVEFORM_HPP
+#define _LCD_WAVEFORM_HPP
+
+#include <cstdint>
+
+#include "lcd_tx_engine.hpp"
+
+namespace lcddriver {
+
+/**
+ * @brief where the lcd signals are on the one gpio port that they all share
+ */
+typedef struct {
+  uint8_t regSelectPin;      //!< RS
+  uint8_t readWritePin;      //!< R/W, 0 if tied low
+  uint8_t enablePin;         //!< EN
+  uint8_t nibbleOutput[16];  //!< D4-D7 levels for each value of the nibble
+} LcdWaveformPinMap;
+
+/**
+ * @brief records the pin levels that an LcdTxEngine would produce, each delay it asks for is
+ * rounded up to whole slots
+ */
+class LcdWaveform : public LcdTxBus {
+ private:
+  LcdWaveformPinMap _pinMap;
+  uint32_t          _slotTime;
+  uint8_t *         _buffer;
+  uint32_t          _capacity;
+  uint32_t          _len;
+  uint8_t           _portOutput;  // levels of the current slot
+  uint32_t          _heldTime;    // part of the current delay already recorded
+
+  /**
+   * @brief repeat the current port output for as many slots as the delay needs
+   */
+  void slotAppend(const uint32_t &delay);
+
+ public:
+  LcdWaveform();
+
+  /**
+   * @brief set where the signals are and where to record them, only call while not recording
+   * @param pinMap the pins on the shared port
+   * @param slotTime nanosec between two port writes
+   * @param buffer where the port values go
+   * @param capacity size of the buffer, has to fit the longest instruction
+   */
+  void configure(const LcdWaveformPinMap &pinMap,
+                 const uint32_t &         slotTime,
+                 uint8_t *                buffer,
+                 const uint32_t &         capacity);
+
+  /**
+   * @brief tick a started engine into the buffer until the queue is done or the next byte doesn't
+   * fit, bytes are never split between two recordings
+   * @param engine the engine to run, its bus has to be this LcdWaveform
+   * @return uint32_t how many slots were recorded, 0 once the engine is idle
+   */
+  uint32_t record(LcdTxEngine &engine);
+
+  /**
+   * @brief mask of every lcd pin on the port, the uDMA writes to the data register through it
+   */
+  uint8_t pinMaskGet(void);
+
+  void txRegisterSelect(const bool &isDataReg) override;
+  void txDataPut(const uint8_t &value) override;
+  void txEnableSwitch(const bool &output) override;
+};
+
+}  // namespace lcddriver
+
+#endif
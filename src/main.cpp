@@ -39,6 +39,20 @@ int main(void) {
   lcdConfig.backLightPin[PIN_DESC_PIN_INDEX]   = GPIO_PIN_6;
   lcdConfig.useBacklight                       = true;
 
+  // poll the busy flag instead of waiting a fixed amount of time between instructions
+  lcdConfig.pacingMode = PACING_BUSY_FLAG;
+
+  // set to true to send from the TIMER1A interrupt instead of waiting, flush() waits for it
+  lcdConfig.isAsync       = false;
+  lcdConfig.isDmaStreamed = false;  // with isAsync, needs every lcd pin on one port
+  lcdConfig.is8BitBus     = false;  // D4-D7 below, set to true and fill in D0-D7 if 8 are wired
+  lcdConfig.isWriteOnly   = false;  // set to true if R/W is tied to ground, F4 is then free
+
+  // the LCD_GEOMETRY_ preset of the panel, a 40x4 has 2 controllers so it needs a second EN too
+  lcdConfig.geometry        = LCD_GEOMETRY_16X2;
+  lcdConfig.totalController = 1;
+  lcdConfig.isBroadcast     = false;  // true to show the same text on a display per EN
+
   // B7 to RS
   lcdConfig.regSelectPin[PIN_DESC_CLOCK_INDEX] = SYSCTL_PERIPH_GPIOB;
   lcdConfig.regSelectPin[PIN_DESC_PORT_INDEX]  = GPIO_PORTB_BASE;
@@ -50,9 +64,9 @@ int main(void) {
   lcdConfig.readWritePin[PIN_DESC_PIN_INDEX]   = GPIO_PIN_4;
 
   // E3 to EN
-  lcdConfig.enablePin[PIN_DESC_CLOCK_INDEX] = SYSCTL_PERIPH_GPIOE;
-  lcdConfig.enablePin[PIN_DESC_PORT_INDEX]  = GPIO_PORTE_BASE;
-  lcdConfig.enablePin[PIN_DESC_PIN_INDEX]   = GPIO_PIN_3;
+  lcdConfig.enablePinList[0][PIN_DESC_CLOCK_INDEX] = SYSCTL_PERIPH_GPIOE;
+  lcdConfig.enablePinList[0][PIN_DESC_PORT_INDEX]  = GPIO_PORTE_BASE;
+  lcdConfig.enablePinList[0][PIN_DESC_PIN_INDEX]   = GPIO_PIN_3;
 
   // E2 to D4
   lcdConfig.parallelPinList[0][PIN_DESC_CLOCK_INDEX] = SYSCTL_PERIPH_GPIOE;
@@ -74,21 +88,35 @@ int main(void) {
   lcdConfig.parallelPinList[3][PIN_DESC_PORT_INDEX]  = GPIO_PORTD_BASE;
   lcdConfig.parallelPinList[3][PIN_DESC_PIN_INDEX]   = GPIO_PIN_6;
 
+  // get timer with millisecond scale
+  auto generalTimer = GeneralTimer(UNIT_MILLISEC);
+  // sleep through waits from 1 ms instead of spinning, like the startup ones of enable() and the
+  // pauses below, needs GeneralTimerIntHandler in the vector table
+  generalTimer.sleepWaitSet(1);
+
   // create and itialize lcd driver class
   auto lcdDriver = LcdDriver(lcdConfig);
+  // a record saved by an earlier boot brings back the timing and the custom characters
+  const bool isRecordLoaded = lcdDriver.recordLoad();
   lcdDriver.init();
   lcdDriver.enable();
-
-  // get timer with millisecond scale
-  auto generalTimer = GeneralTimer(UNIT_MILLISEC);
-
-  // create character pattern
-  uint8_t charPattern0[] = {0b11111, 0b11000, 0b10100, 0b10111, 0b10101, 0b10101, 0b10101, 0b11111};
-  uint8_t charPattern1[] = {0b10000, 0b01111, 0b01001, 0b01001, 0b01001, 0b01001, 0b01001, 0b01001};
-  uint8_t charPattern2[] = {0b10000, 0b01000, 0b01011, 0b01110, 0b01010, 0b00010, 0b00010, 0b00010};
-  lcdDriver.newCustomCharAdd(charPattern0, 0);
-  lcdDriver.newCustomCharAdd(charPattern1, 1);
-  lcdDriver.newCustomCharAdd(charPattern2, 2);
+  // the reset causes are sticky, clear them so the next reset isn't taken for a power on
+  SysCtlResetCauseClear(SysCtlResetCauseGet());
+
+  if (!isRecordLoaded) {
+    // find the shortest bus timing this lcd handles, b4 the custom characters since it may lose
+    // them
+    lcdDriver.timingCalibrate();
+
+    // create character pattern
+    uint8_t charPattern0[] = {0b11111, 0b11000, 0b10100, 0b10111, 0b10101, 0b10101, 0b10101, 0b11111};
+    uint8_t charPattern1[] = {0b10000, 0b01111, 0b01001, 0b01001, 0b01001, 0b01001, 0b01001, 0b01001};
+    uint8_t charPattern2[] = {0b10000, 0b01000, 0b01011, 0b01110, 0b01010, 0b00010, 0b00010, 0b00010};
+    lcdDriver.newCustomCharAdd(charPattern0, 0);
+    lcdDriver.newCustomCharAdd(charPattern1, 1);
+    lcdDriver.newCustomCharAdd(charPattern2, 2);
+    lcdDriver.recordSave();
+  }
   lcdDriver.lcdReset();
   for (;;) {
     // write some custom char and string